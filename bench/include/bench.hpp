@@ -0,0 +1,51 @@
+#ifndef FAUXBOY_BENCH_BENCH_HPP
+#define FAUXBOY_BENCH_BENCH_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal benchmark harness, every benchmark is a setup function returning the body that gets timed so the state it
+// works on is built once outside of the measurement
+namespace Bench
+{
+using Body  = std::move_only_function<void(std::uint64_t iterations)>;
+using Setup = std::function<Body()>;
+
+struct Benchmark
+{
+    std::string name;
+    // What one iteration of the body stands for, reported next to the timings
+    std::string unit;
+    Setup setup;
+};
+
+[[nodiscard]] std::vector<Benchmark>& registry();
+
+struct Registrar
+{
+    Registrar(std::string name, std::string unit, Setup setup)
+    {
+        registry().push_back({.name = std::move(name), .unit = std::move(unit), .setup = std::move(setup)});
+    }
+};
+
+// Forces value to be materialised without letting the compiler see it being used
+template <typename T>
+inline void doNotOptimize(T const& value) noexcept
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Returns value unchanged while hiding where it came from, stops constant folding and devirtualisation through it
+template <typename T>
+[[nodiscard]] inline T opaque(T value) noexcept
+{
+    asm volatile("" : "+r"(value));
+    return value;
+}
+} // namespace Bench
+
+#endif // FAUXBOY_BENCH_BENCH_HPP
\ No newline at end of file
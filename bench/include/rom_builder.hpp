@@ -0,0 +1,76 @@
+#ifndef FAUXBOY_BENCH_ROM_BUILDER_HPP
+#define FAUXBOY_BENCH_ROM_BUILDER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Bench
+{
+// Assembles a cartridge image from raw opcodes, jumps can target labels that are resolved once the image is built.
+// Addresses are the ones seen by the cpu so code placed in a switchable bank is labelled inside 0x4000-0x7FFF
+class RomBuilder
+{
+public:
+    static constexpr std::size_t BANK_SIZE     = 0x4000;
+    static constexpr std::uint16_t ENTRY_POINT = 0x0100;
+    static constexpr std::uint16_t CODE_START  = 0x0150;
+
+    enum class CartridgeType : std::uint8_t
+    {
+        ROM_ONLY = 0x00,
+        MBC1     = 0x01
+    };
+
+private:
+    enum class FixupKind
+    {
+        RELATIVE,
+        ABSOLUTE
+    };
+
+    struct Fixup
+    {
+        std::size_t offset;
+        std::uint16_t address;
+        std::string label;
+        FixupKind kind;
+    };
+
+    std::vector<std::uint8_t> rom_;
+    std::size_t offset_ = CODE_START;
+    std::map<std::string, std::uint16_t, std::less<>> labels_;
+    std::vector<Fixup> fixups_;
+
+private:
+    [[nodiscard]] std::uint16_t address() const noexcept;
+
+public:
+    // Unused space is padded with 0xFF, banks has to be a power of two of at least 2
+    explicit RomBuilder(std::size_t banks = 2);
+
+    // Moves the output to address as seen from the cpu, bank selects what is mapped into 0x4000-0x7FFF
+    void org(std::uint16_t address, std::size_t bank = 1);
+
+    void label(std::string name);
+
+    void emit(std::initializer_list<std::uint8_t> bytes);
+    void emit(std::span<std::uint8_t const> bytes);
+
+    // opcode followed by the signed 8-bit distance to label, for JR and JR cc
+    void emitRelative(std::uint8_t opcode, std::string label);
+    // opcode followed by the little endian address of label, for JP, CALL and 16-bit loads
+    void emitAbsolute(std::uint8_t opcode, std::string label);
+
+    // Resolves every label, then writes the header and both checksums, throws on unknown labels or out of range jumps
+    [[nodiscard]] std::vector<std::uint8_t> build(std::string_view title, CartridgeType type);
+};
+} // namespace Bench
+
+#endif // FAUXBOY_BENCH_ROM_BUILDER_HPP
\ No newline at end of file
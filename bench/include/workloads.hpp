@@ -0,0 +1,26 @@
+#ifndef FAUXBOY_BENCH_WORKLOADS_HPP
+#define FAUXBOY_BENCH_WORKLOADS_HPP
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Synthetic cartridges, each one loops forever on a single kind of work so a benchmark or regression run can target
+// one part of the emulator without depending on commercial roms
+namespace Bench
+{
+struct Workload
+{
+    std::string_view name;
+    std::string_view description;
+    std::vector<std::uint8_t> (*build)();
+};
+
+[[nodiscard]] std::span<Workload const> workloads() noexcept;
+
+// Throws when there is no workload with that name
+[[nodiscard]] Workload const& findWorkload(std::string_view name);
+} // namespace Bench
+
+#endif // FAUXBOY_BENCH_WORKLOADS_HPP
\ No newline at end of file
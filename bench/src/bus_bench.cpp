@@ -0,0 +1,79 @@
+#include <cstdint>
+#include <memory>
+
+#include <fauxboy/address.hpp>
+#include <fauxboy/bus.hpp>
+#include <fauxboy/flat_bus.hpp>
+
+#include "bench.hpp"
+
+using namespace fxb;
+
+namespace
+{
+// The cpu only ever sees a Bus*, these go through the vtable the same way
+Bench::Body virtualRead()
+{
+    return [bus = std::make_unique<FlatBus>()](std::uint64_t iterations)
+    {
+        Bus* const target = Bench::opaque(static_cast<Bus*>(bus.get()));
+
+        std::uint8_t sum = 0;
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            sum += target->read(Address(static_cast<std::uint16_t>(i)));
+        }
+        Bench::doNotOptimize(sum);
+    };
+}
+
+Bench::Body virtualWrite()
+{
+    return [bus = std::make_unique<FlatBus>()](std::uint64_t iterations)
+    {
+        Bus* const target = Bench::opaque(static_cast<Bus*>(bus.get()));
+
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            target->write(Address(static_cast<std::uint16_t>(i)), static_cast<std::uint8_t>(i));
+        }
+        Bench::doNotOptimize(bus->memory()[0]);
+    };
+}
+
+// The qualified calls are bound statically and can be inlined, this is the floor the virtual interface is measured
+// against
+Bench::Body concreteRead()
+{
+    return [bus = std::make_unique<FlatBus>()](std::uint64_t iterations)
+    {
+        FlatBus* const target = Bench::opaque(bus.get());
+
+        std::uint8_t sum = 0;
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            sum += target->FlatBus::read(Address(static_cast<std::uint16_t>(i)));
+        }
+        Bench::doNotOptimize(sum);
+    };
+}
+
+Bench::Body concreteWrite()
+{
+    return [bus = std::make_unique<FlatBus>()](std::uint64_t iterations)
+    {
+        FlatBus* const target = Bench::opaque(bus.get());
+
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            target->FlatBus::write(Address(static_cast<std::uint16_t>(i)), static_cast<std::uint8_t>(i));
+        }
+        Bench::doNotOptimize(bus->memory()[0]);
+    };
+}
+
+Bench::Registrar const virtualReadBenchmark("bus/read/virtual", "access", virtualRead);
+Bench::Registrar const virtualWriteBenchmark("bus/write/virtual", "access", virtualWrite);
+Bench::Registrar const concreteReadBenchmark("bus/read/concrete", "access", concreteRead);
+Bench::Registrar const concreteWriteBenchmark("bus/write/concrete", "access", concreteWrite);
+} // namespace
\ No newline at end of file
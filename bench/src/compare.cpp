@@ -0,0 +1,277 @@
+// Compares two sets of fauxboy_bench results and fails when a benchmark got slower than the threshold allows
+//
+// usage: fauxboy_bench_compare --baseline <json>... --contender <json>... [--threshold PCT] [--sigma K]
+//
+// Both sides take any number of result files, every file is one run of the suite. The noise of a benchmark is the
+// larger of the spread within a run (MAD of the samples) and the spread between runs (deviation of the run medians),
+// a delta only counts when it is more than sigma times the combined noise of both sides
+
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <simdjson.h>
+
+namespace
+{
+// Scales a MAD to the standard deviation of normally distributed samples
+constexpr double MAD_TO_STDDEV = 1.4826;
+
+struct Options
+{
+    std::vector<std::filesystem::path> baseline;
+    std::vector<std::filesystem::path> contender;
+    double threshold = 5.0;
+    double sigma     = 3.0;
+};
+
+struct Series
+{
+    std::string unit;
+    std::vector<double> runMedians;
+    std::vector<double> samples;
+};
+
+using Results = std::map<std::string, Series, std::less<>>;
+
+struct Estimate
+{
+    double median = 0.0;
+    // Relative to the median
+    double noise = 0.0;
+};
+
+double median(std::vector<double> values)
+{
+    std::ranges::sort(values);
+    auto const middle = (values.size() / 2);
+    return (((values.size() % 2) == 1) ? values[middle] : ((values[middle - 1] + values[middle]) / 2.0));
+}
+
+Estimate estimate(Series const& series)
+{
+    auto const center = median(series.samples);
+
+    std::vector<double> deviations;
+    for (double const sample : series.samples)
+    {
+        deviations.push_back(std::abs(sample - center));
+    }
+    double const within = (MAD_TO_STDDEV * median(std::move(deviations)));
+
+    double between = 0.0;
+    if (series.runMedians.size() > 1)
+    {
+        double mean = 0.0;
+        for (double const runMedian : series.runMedians)
+        {
+            mean += runMedian;
+        }
+        mean /= static_cast<double>(series.runMedians.size());
+
+        for (double const runMedian : series.runMedians)
+        {
+            between += ((runMedian - mean) * (runMedian - mean));
+        }
+        between = std::sqrt(between / static_cast<double>(series.runMedians.size() - 1));
+    }
+
+    return {.median = center, .noise = ((center > 0.0) ? (std::max(within, between) / center) : 0.0)};
+}
+
+void load(std::filesystem::path const& path, simdjson::ondemand::parser& parser, Results& results)
+{
+    simdjson::padded_string json;
+    if (simdjson::padded_string::load(path.string()).get(json) != simdjson::SUCCESS)
+    {
+        throw std::runtime_error(std::format("Could not read file: {}", path.c_str()));
+    }
+
+    auto document = parser.iterate(json);
+    if (std::uint64_t{document["version"]} != 1)
+    {
+        throw std::runtime_error(std::format("Unsupported result version in {}", path.c_str()));
+    }
+
+    for (simdjson::ondemand::object benchmark : document["benchmarks"])
+    {
+        std::string_view const name = benchmark["name"];
+        std::string_view const unit = benchmark["unit"];
+
+        auto& series = results[std::string(name)];
+        if (series.unit.empty())
+        {
+            series.unit = unit;
+        }
+        else if (series.unit != unit)
+        {
+            throw std::runtime_error(std::format("{} is measured in {} and {}", name, series.unit, unit));
+        }
+
+        series.runMedians.push_back(double{benchmark["median"]});
+        for (double const sample : benchmark["samples"])
+        {
+            series.samples.push_back(sample);
+        }
+    }
+}
+
+Results loadAll(std::vector<std::filesystem::path> const& paths)
+{
+    simdjson::ondemand::parser parser;
+    Results results;
+    for (auto const& path : paths)
+    {
+        load(path, parser, results);
+    }
+    return results;
+}
+
+int compare(Options const& options)
+{
+    auto const baseline  = loadAll(options.baseline);
+    auto const contender = loadAll(options.contender);
+
+    std::cout << std::format(
+        "{:<32}{:>14}{:>14}  {:<16}{:>9}{:>8}\n", "benchmark", "baseline", "contender", "unit", "delta", "noise");
+
+    int regressions = 0;
+    for (auto const& [name, before] : baseline)
+    {
+        auto const itr = contender.find(name);
+        if (itr == contender.end())
+        {
+            std::cout << std::format("{:<32}{:>14.2f}{:>14}  {:<16}{:>9}{:>8}  removed\n",
+                                     name,
+                                     estimate(before).median,
+                                     "",
+                                     before.unit,
+                                     "",
+                                     "");
+            continue;
+        }
+
+        auto const& after = itr->second;
+        if (before.unit != after.unit)
+        {
+            throw std::runtime_error(std::format("{} changed unit from {} to {}", name, before.unit, after.unit));
+        }
+
+        auto const old     = estimate(before);
+        auto const current = estimate(after);
+
+        double const delta = ((old.median > 0.0) ? ((current.median - old.median) / old.median) : 0.0);
+        double const noise = std::hypot(old.noise, current.noise);
+
+        std::string_view verdict = "same";
+        if (std::abs(delta) > (options.sigma * noise))
+        {
+            verdict = ((delta < 0.0) ? "faster" : "slower");
+            if ((delta * 100.0) > options.threshold)
+            {
+                verdict = "REGRESSION";
+                ++regressions;
+            }
+        }
+
+        std::cout << std::format("{:<32}{:>14.2f}{:>14.2f}  {:<16}{:>+8.1f}%{:>7.1f}%  {}\n",
+                                 name,
+                                 old.median,
+                                 current.median,
+                                 before.unit,
+                                 (delta * 100.0),
+                                 (noise * 100.0),
+                                 verdict);
+    }
+
+    for (auto const& [name, after] : contender)
+    {
+        if (!baseline.contains(name))
+        {
+            std::cout << std::format("{:<32}{:>14}{:>14.2f}  {:<16}{:>9}{:>8}  added\n",
+                                     name,
+                                     "",
+                                     estimate(after).median,
+                                     after.unit,
+                                     "",
+                                     "");
+        }
+    }
+
+    if (regressions > 0)
+    {
+        std::cout << std::format("\n{} benchmark(s) regressed by more than {}%\n", regressions, options.threshold);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+Options parseOptions(int argc, char* argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view const arg = argv[i];
+
+        auto const nextValue = [&]
+        {
+            if ((i + 1) >= argc)
+            {
+                throw std::invalid_argument(std::format("Missing value for {}", arg));
+            }
+            return std::string_view(argv[++i]);
+        };
+
+        if (arg == "--baseline")
+        {
+            options.baseline.emplace_back(nextValue());
+        }
+        else if (arg == "--contender")
+        {
+            options.contender.emplace_back(nextValue());
+        }
+        else if (arg == "--threshold")
+        {
+            options.threshold = std::stod(std::string(nextValue()));
+        }
+        else if (arg == "--sigma")
+        {
+            options.sigma = std::stod(std::string(nextValue()));
+        }
+        else
+        {
+            throw std::invalid_argument(std::format("Unknown argument: {}", arg));
+        }
+    }
+
+    if (options.baseline.empty() || options.contender.empty())
+    {
+        throw std::invalid_argument("usage: fauxboy_bench_compare --baseline <json>... --contender <json>... "
+                                    "[--threshold PCT] [--sigma K]");
+    }
+    return options;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        return compare(parseOptions(argc, argv));
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << '\n';
+        return 2;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <fauxboy/cpu.hpp>
+#include <fauxboy/flat_bus.hpp>
+#include <fauxboy/register.hpp>
+
+#include "bench.hpp"
+
+using namespace fxb;
+
+namespace
+{
+struct Machine
+{
+    FlatBus bus;
+    Cpu cpu = Cpu(&bus);
+};
+
+// Fills the whole address space with the pattern, the program counter wraps around so the cpu never leaves it
+std::unique_ptr<Machine> makeSled(std::span<std::uint8_t const> pattern)
+{
+    auto machine = std::make_unique<Machine>();
+
+    auto memory = machine->bus.memory();
+    for (std::size_t i = 0; i < memory.size(); ++i)
+    {
+        memory[i] = pattern[i % pattern.size()];
+    }
+    return machine;
+}
+
+Bench::Body stepSled(std::vector<std::uint8_t> const& pattern)
+{
+    return [machine = makeSled(pattern)](std::uint64_t iterations)
+    {
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            machine->cpu.step();
+        }
+        Bench::doNotOptimize(machine->cpu.A());
+    };
+}
+
+// Register to register loads and loads from (HL), the LD (HL),r row and HALT are left out since the stores would write
+// into the program and change the mix of instructions while it runs
+std::vector<std::uint8_t> loadOpcodes()
+{
+    std::vector<std::uint8_t> opcodes;
+    for (int opcode = 0x40; opcode < 0x80; ++opcode)
+    {
+        if ((opcode < 0x70) || (opcode > 0x77))
+        {
+            opcodes.push_back(static_cast<std::uint8_t>(opcode));
+        }
+    }
+    return opcodes;
+}
+
+// Every 8-bit alu operation with a register or (HL) operand
+std::vector<std::uint8_t> aluOpcodes()
+{
+    std::vector<std::uint8_t> opcodes;
+    for (int opcode = 0x80; opcode < 0xC0; ++opcode)
+    {
+        opcodes.push_back(static_cast<std::uint8_t>(opcode));
+    }
+    return opcodes;
+}
+
+// CB prefixed instructions on registers, the (HL) forms are left out since they would write into the program
+std::vector<std::uint8_t> cbOpcodes()
+{
+    std::vector<std::uint8_t> opcodes;
+    for (int offset = 0x00; offset < 0x100; ++offset)
+    {
+        if ((offset & 0x07) != 0x06)
+        {
+            opcodes.push_back(0xCB);
+            opcodes.push_back(static_cast<std::uint8_t>(offset));
+        }
+    }
+    return opcodes;
+}
+
+Bench::Registrar const dispatchNop("cpu/dispatch/nop", "instruction", [] { return stepSled({0x00}); });
+Bench::Registrar const dispatchLoad("cpu/dispatch/ld_r_r", "instruction", [] { return stepSled(loadOpcodes()); });
+Bench::Registrar const aluRegister("cpu/alu/register", "instruction", [] { return stepSled(aluOpcodes()); });
+Bench::Registrar const aluCb("cpu/alu/cb", "instruction", [] { return stepSled(cbOpcodes()); });
+
+struct PairFixture
+{
+    ByteRegister upper;
+    ByteRegister lower;
+    RegisterPairView pair = {&upper, &lower};
+};
+
+Bench::Body pairRead()
+{
+    return [fixture = std::make_unique<PairFixture>()](std::uint64_t iterations)
+    {
+        auto* const pair = Bench::opaque(&fixture->pair);
+
+        std::uint16_t sum = 0;
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            sum += (*pair)();
+            fixture->lower = static_cast<std::uint8_t>(i);
+        }
+        Bench::doNotOptimize(sum);
+    };
+}
+
+Bench::Body pairWrite()
+{
+    return [fixture = std::make_unique<PairFixture>()](std::uint64_t iterations)
+    {
+        auto* const pair = Bench::opaque(&fixture->pair);
+
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            pair->upper() = getUpper(static_cast<std::uint16_t>(i));
+            pair->lower() = getLower(static_cast<std::uint16_t>(i));
+        }
+        Bench::doNotOptimize(fixture->upper());
+    };
+}
+
+Bench::Registrar const pairReadBenchmark("register/pair_view/read", "access", pairRead);
+Bench::Registrar const pairWriteBenchmark("register/pair_view/write", "access", pairWrite);
+} // namespace
\ No newline at end of file
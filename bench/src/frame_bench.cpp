@@ -0,0 +1,42 @@
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <utility>
+
+#include <fauxboy/cartridge.hpp>
+#include <fauxboy/game_boy.hpp>
+
+#include "bench.hpp"
+#include "workloads.hpp"
+
+namespace
+{
+// The whole machine from the post boot state, so banking, the page table of the mmu and lcd timing are measured along
+// with the cpu
+Bench::Body runFrames(Bench::Workload const& workload)
+{
+    auto gameBoy = std::make_unique<fxb::GameBoy>(fxb::Cartridge(workload.build()));
+    return [gameBoy = std::move(gameBoy)](std::uint64_t iterations)
+    {
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            gameBoy->runFrame();
+        }
+        Bench::doNotOptimize(gameBoy->cpu().PC());
+    };
+}
+
+// One benchmark per synthetic rom
+bool registerWorkloads()
+{
+    for (auto const& workload : Bench::workloads())
+    {
+        Bench::registry().push_back({.name  = std::format("frame/{}", workload.name),
+                                     .unit  = "frame",
+                                     .setup = [&workload] { return runFrames(workload); }});
+    }
+    return true;
+}
+
+[[maybe_unused]] bool const workloadsRegistered = registerWorkloads();
+} // namespace
\ No newline at end of file
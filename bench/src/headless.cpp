@@ -0,0 +1,145 @@
+// Runs roms headlessly for a fixed number of frames, used to train the profile of a PGO build and handy under a
+// profiler
+//
+// usage: fauxboy_headless <rom_or_dir>... [--frames N] [--boot-rom PATH]
+
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <format>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fauxboy/cartridge.hpp>
+#include <fauxboy/game_boy.hpp>
+
+using namespace fxb;
+
+namespace
+{
+struct Options
+{
+    std::vector<std::filesystem::path> roms;
+    std::uint64_t frames = 600;
+    // Every rom starts in the post boot state unless given
+    std::filesystem::path bootRom;
+};
+
+// Directories contribute every .gb and .gbc file below them
+void addRoms(std::filesystem::path const& path, std::vector<std::filesystem::path>& roms)
+{
+    if (!std::filesystem::is_directory(path))
+    {
+        roms.push_back(path);
+        return;
+    }
+
+    std::vector<std::filesystem::path> found;
+    for (auto const& entry : std::filesystem::recursive_directory_iterator(path))
+    {
+        auto const extension = entry.path().extension();
+        if (entry.is_regular_file() && ((extension == ".gb") || (extension == ".gbc")))
+        {
+            found.push_back(entry.path());
+        }
+    }
+    std::ranges::sort(found);
+    roms.insert(roms.end(), found.begin(), found.end());
+}
+
+Options parseOptions(int argc, char* argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view const arg = argv[i];
+
+        if (arg == "--frames")
+        {
+            if ((i + 1) >= argc)
+            {
+                throw std::invalid_argument(std::format("Missing value for {}", arg));
+            }
+            options.frames = std::stoull(argv[++i]);
+        }
+        else if (arg == "--boot-rom")
+        {
+            if ((i + 1) >= argc)
+            {
+                throw std::invalid_argument(std::format("Missing value for {}", arg));
+            }
+            options.bootRom = argv[++i];
+        }
+        else
+        {
+            addRoms(arg, options.roms);
+        }
+    }
+
+    if (options.roms.empty())
+    {
+        throw std::invalid_argument("usage: fauxboy_headless <rom_or_dir>... [--frames N] [--boot-rom PATH]");
+    }
+    return options;
+}
+
+std::vector<std::uint8_t> loadBootRom(std::filesystem::path const& path)
+{
+    if (path.empty())
+    {
+        return {};
+    }
+
+    auto ifs = std::ifstream(path, std::ios::binary);
+    if (!ifs.is_open())
+    {
+        throw std::runtime_error(std::format("Could not open file: {}", path.c_str()));
+    }
+    return std::vector<std::uint8_t>(std::istreambuf_iterator(ifs), {});
+}
+
+int run(Options const& options)
+{
+    auto const bootRom = loadBootRom(options.bootRom);
+    for (auto const& path : options.roms)
+    {
+        GameBoy gameBoy(Cartridge::load(path), bootRom);
+
+        auto const start = std::chrono::steady_clock::now();
+        for (std::uint64_t frame = 0; frame < options.frames; ++frame)
+        {
+            gameBoy.runFrame();
+        }
+        auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+        // Real time runs at about 59.7 frames per second
+        std::cout << std::format("{:<40}{:>8} frames{:>10.3f} s{:>10.1f}x\n",
+                                 path.filename().c_str(),
+                                 options.frames,
+                                 elapsed.count(),
+                                 ((static_cast<double>(options.frames) / 59.7275) / elapsed.count()));
+    }
+    return EXIT_SUCCESS;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        return run(parseOptions(argc, argv));
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}
\ No newline at end of file
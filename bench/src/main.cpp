@@ -0,0 +1,267 @@
+// Runs the registered benchmarks and prints the results as json
+//
+// usage: fauxboy_bench [--filter <substring>] [--samples N] [--min-time-ms N] [--output <path>] [--list]
+
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace Bench
+{
+std::vector<Benchmark>& registry()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+} // namespace Bench
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct Options
+{
+    std::string filter;
+    int samples                      = 15;
+    std::chrono::nanoseconds minTime = std::chrono::milliseconds(20);
+    std::filesystem::path output;
+    bool list = false;
+};
+
+struct Result
+{
+    std::string_view name;
+    std::string_view unit;
+    std::uint64_t iterations = 0;
+    // Nanoseconds per iteration, one entry per sample in the order they were taken
+    std::vector<double> samples;
+};
+
+double time(Bench::Body& body, std::uint64_t iterations)
+{
+    auto const start = Clock::now();
+    body(iterations);
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+// Doubles the iteration count until a run is long enough to extrapolate from, then scales it so a single sample takes
+// about minTime, this also serves as the warm up
+std::uint64_t calibrate(Bench::Body& body, std::chrono::nanoseconds minTime)
+{
+    auto const target = static_cast<double>(minTime.count());
+
+    std::uint64_t iterations = 1;
+    while (true)
+    {
+        auto const elapsed = time(body, iterations);
+        if (elapsed >= (target / 10.0))
+        {
+            auto const scaled = std::ceil(static_cast<double>(iterations) * (target / elapsed));
+            return std::max<std::uint64_t>(1, static_cast<std::uint64_t>(scaled));
+        }
+        iterations *= 2;
+    }
+}
+
+Result run(Bench::Benchmark const& benchmark, Options const& options)
+{
+    auto body = benchmark.setup();
+
+    Result result;
+    result.name       = benchmark.name;
+    result.unit       = benchmark.unit;
+    result.iterations = calibrate(body, options.minTime);
+
+    result.samples.reserve(options.samples);
+    for (int i = 0; i < options.samples; ++i)
+    {
+        result.samples.push_back(time(body, result.iterations) / static_cast<double>(result.iterations));
+    }
+    return result;
+}
+
+double median(std::vector<double> values)
+{
+    std::ranges::sort(values);
+    auto const middle = (values.size() / 2);
+    return (((values.size() % 2) == 1) ? values[middle] : ((values[middle - 1] + values[middle]) / 2.0));
+}
+
+std::string escape(std::string_view text)
+{
+    std::string escaped;
+    for (char const c : text)
+    {
+        if ((c == '"') || (c == '\\'))
+        {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+// Benchmarks are written in name order with fixed precision so two reports of the same build only differ in the numbers
+void writeJson(std::ostream& os, std::vector<Result> const& results, Options const& options)
+{
+    os << "{\n";
+    os << "  \"version\": 1,\n";
+    os << std::format("  \"compiler\": \"{}\",\n", escape(__VERSION__));
+#ifdef NDEBUG
+    os << "  \"assertions\": false,\n";
+#else
+    os << "  \"assertions\": true,\n";
+#endif
+    os << std::format("  \"samples\": {},\n", options.samples);
+    os << std::format("  \"min_time_ns\": {},\n", options.minTime.count());
+    os << "  \"benchmarks\": [";
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        auto const& result  = results[i];
+        auto const& samples = result.samples;
+
+        auto const mean   = (std::reduce(samples.begin(), samples.end()) / static_cast<double>(samples.size()));
+        auto const middle = median(samples);
+
+        double variance = 0.0;
+        std::vector<double> deviations;
+        for (double const sample : samples)
+        {
+            variance += ((sample - mean) * (sample - mean));
+            deviations.push_back(std::abs(sample - middle));
+        }
+        variance /= static_cast<double>(samples.size());
+
+        os << ((i == 0) ? "\n" : ",\n");
+        os << "    {\n";
+        os << std::format("      \"name\": \"{}\",\n", escape(result.name));
+        os << std::format("      \"unit\": \"ns/{}\",\n", escape(result.unit));
+        os << std::format("      \"iterations\": {},\n", result.iterations);
+        os << std::format("      \"min\": {:.3f},\n", std::ranges::min(samples));
+        os << std::format("      \"median\": {:.3f},\n", middle);
+        os << std::format("      \"mean\": {:.3f},\n", mean);
+        os << std::format("      \"stddev\": {:.3f},\n", std::sqrt(variance));
+        os << std::format("      \"mad\": {:.3f},\n", median(std::move(deviations)));
+        os << "      \"samples\": [";
+        for (std::size_t j = 0; j < samples.size(); ++j)
+        {
+            os << std::format("{}{:.3f}", ((j == 0) ? "" : ", "), samples[j]);
+        }
+        os << "]\n";
+        os << "    }";
+    }
+
+    os << "\n  ]\n";
+    os << "}\n";
+}
+
+Options parseOptions(int argc, char* argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view const arg = argv[i];
+        bool const hasValue        = ((i + 1) < argc);
+
+        if ((arg == "--filter") && hasValue)
+        {
+            options.filter = argv[++i];
+        }
+        else if ((arg == "--samples") && hasValue)
+        {
+            options.samples = std::max(1, std::stoi(argv[++i]));
+        }
+        else if ((arg == "--min-time-ms") && hasValue)
+        {
+            options.minTime = std::chrono::milliseconds(std::max(1, std::stoi(argv[++i])));
+        }
+        else if ((arg == "--output") && hasValue)
+        {
+            options.output = argv[++i];
+        }
+        else if (arg == "--list")
+        {
+            options.list = true;
+        }
+        else
+        {
+            throw std::invalid_argument(std::format("Unknown argument: {}\nusage: fauxboy_bench [--filter <substring>] "
+                                                    "[--samples N] [--min-time-ms N] [--output <path>] [--list]",
+                                                    arg));
+        }
+    }
+
+    return options;
+}
+
+int bench(Options const& options)
+{
+    auto benchmarks = std::vector<Bench::Benchmark const*>();
+    for (auto const& benchmark : Bench::registry())
+    {
+        if (benchmark.name.contains(options.filter))
+        {
+            benchmarks.push_back(&benchmark);
+        }
+    }
+    std::ranges::sort(benchmarks, {}, &Bench::Benchmark::name);
+
+    if (options.list)
+    {
+        for (auto const* benchmark : benchmarks)
+        {
+            std::cout << benchmark->name << '\n';
+        }
+        return EXIT_SUCCESS;
+    }
+
+    std::vector<Result> results;
+    for (auto const* benchmark : benchmarks)
+    {
+        std::cerr << benchmark->name << '\n';
+        results.push_back(run(*benchmark, options));
+    }
+
+    if (options.output.empty())
+    {
+        writeJson(std::cout, results, options);
+        return EXIT_SUCCESS;
+    }
+
+    auto ofs = std::ofstream(options.output, std::ios::trunc);
+    if (!ofs.is_open())
+    {
+        throw std::runtime_error(std::format("Could not open file: {}", options.output.c_str()));
+    }
+    writeJson(ofs, results, options);
+    return EXIT_SUCCESS;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        return bench(parseOptions(argc, argv));
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}
\ No newline at end of file
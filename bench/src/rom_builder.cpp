@@ -0,0 +1,173 @@
+#include "rom_builder.hpp"
+
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fauxboy/util.hpp>
+
+namespace Bench
+{
+namespace
+{
+// Checked by the boot rom before it hands over to the cartridge
+constexpr std::array<std::uint8_t, 48> LOGO = {
+    0xCE, 0xED, 0x66, 0x66, 0xCC, 0x0D, 0x00, 0x0B, 0x03, 0x73, 0x00, 0x83, 0x00, 0x0C, 0x00, 0x0D,
+    0x00, 0x08, 0x11, 0x1F, 0x88, 0x89, 0x00, 0x0E, 0xDC, 0xCC, 0x6E, 0xE6, 0xDD, 0xDD, 0xD9, 0x99,
+    0xBB, 0xBB, 0x67, 0x63, 0x6E, 0x0E, 0xEC, 0xCC, 0xDD, 0xDC, 0x99, 0x9F, 0xBB, 0xB9, 0x33, 0x3E,
+};
+
+constexpr std::size_t LOGO_OFFSET            = 0x0104;
+constexpr std::size_t TITLE_OFFSET           = 0x0134;
+constexpr std::size_t MAX_TITLE_LENGTH       = 15;
+constexpr std::size_t CARTRIDGE_TYPE_OFFSET  = 0x0147;
+constexpr std::size_t ROM_SIZE_OFFSET        = 0x0148;
+constexpr std::size_t DESTINATION_OFFSET     = 0x014A;
+constexpr std::size_t HEADER_CHECKSUM_OFFSET = 0x014D;
+constexpr std::size_t GLOBAL_CHECKSUM_OFFSET = 0x014E;
+} // namespace
+
+RomBuilder::RomBuilder(std::size_t banks)
+{
+    if ((banks < 2) || !std::has_single_bit(banks))
+    {
+        throw std::invalid_argument(std::format("Invalid bank count: {}", banks));
+    }
+    rom_.resize(banks * BANK_SIZE, 0xFF);
+}
+
+std::uint16_t RomBuilder::address() const noexcept
+{
+    if (offset_ < BANK_SIZE)
+    {
+        return static_cast<std::uint16_t>(offset_);
+    }
+    return static_cast<std::uint16_t>(BANK_SIZE + (offset_ % BANK_SIZE));
+}
+
+void RomBuilder::org(std::uint16_t address, std::size_t bank)
+{
+    if (address < BANK_SIZE)
+    {
+        offset_ = address;
+        return;
+    }
+
+    if ((address >= (2 * BANK_SIZE)) || (bank == 0) || (bank >= (rom_.size() / BANK_SIZE)))
+    {
+        throw std::out_of_range(std::format("0x{:04X} in bank {} is outside of the rom", address, bank));
+    }
+    offset_ = ((bank * BANK_SIZE) + (address - BANK_SIZE));
+}
+
+void RomBuilder::label(std::string name)
+{
+    auto const [itr, inserted] = labels_.try_emplace(std::move(name), address());
+    if (!inserted)
+    {
+        throw std::invalid_argument(std::format("Duplicate label: {}", itr->first));
+    }
+}
+
+void RomBuilder::emit(std::initializer_list<std::uint8_t> bytes)
+{
+    emit(std::span(bytes.begin(), bytes.size()));
+}
+
+void RomBuilder::emit(std::span<std::uint8_t const> bytes)
+{
+    if (bytes.size() > (rom_.size() - offset_))
+    {
+        throw std::out_of_range("Code runs past the end of the rom");
+    }
+    std::ranges::copy(bytes, rom_.begin() + offset_);
+    offset_ += bytes.size();
+}
+
+void RomBuilder::emitRelative(std::uint8_t opcode, std::string label)
+{
+    emit({opcode});
+    fixups_.push_back(
+        {.offset = offset_, .address = address(), .label = std::move(label), .kind = FixupKind::RELATIVE});
+    emit({0x00});
+}
+
+void RomBuilder::emitAbsolute(std::uint8_t opcode, std::string label)
+{
+    emit({opcode});
+    fixups_.push_back(
+        {.offset = offset_, .address = address(), .label = std::move(label), .kind = FixupKind::ABSOLUTE});
+    emit({0x00, 0x00});
+}
+
+std::vector<std::uint8_t> RomBuilder::build(std::string_view title, CartridgeType type)
+{
+    for (auto const& fixup : fixups_)
+    {
+        auto const itr = labels_.find(fixup.label);
+        if (itr == labels_.end())
+        {
+            throw std::invalid_argument(std::format("Unknown label: {}", fixup.label));
+        }
+
+        auto const target = itr->second;
+        if (fixup.kind == FixupKind::ABSOLUTE)
+        {
+            rom_[fixup.offset]     = fxb::getLower(target);
+            rom_[fixup.offset + 1] = fxb::getUpper(target);
+            continue;
+        }
+
+        // Relative to the address following the operand
+        auto const distance = (static_cast<int>(target) - (static_cast<int>(fixup.address) + 1));
+        if ((distance < -128) || (distance > 127))
+        {
+            throw std::out_of_range(std::format("Label {} is out of range for a relative jump", fixup.label));
+        }
+        rom_[fixup.offset] = static_cast<std::uint8_t>(distance);
+    }
+
+    if (title.size() > MAX_TITLE_LENGTH)
+    {
+        throw std::invalid_argument(std::format("Title too long: {}", title));
+    }
+
+    // NOP, JP CODE_START
+    std::ranges::copy(std::to_array<std::uint8_t>({0x00, 0xC3, fxb::getLower(CODE_START), fxb::getUpper(CODE_START)}),
+                      rom_.begin() + ENTRY_POINT);
+    std::ranges::copy(LOGO, rom_.begin() + LOGO_OFFSET);
+    std::fill(rom_.begin() + TITLE_OFFSET, rom_.begin() + CARTRIDGE_TYPE_OFFSET, 0x00);
+    std::ranges::copy(title, rom_.begin() + TITLE_OFFSET);
+
+    rom_[CARTRIDGE_TYPE_OFFSET] = static_cast<std::uint8_t>(type);
+    rom_[ROM_SIZE_OFFSET]       = static_cast<std::uint8_t>(std::countr_zero(rom_.size() / (2 * BANK_SIZE)));
+    rom_[ROM_SIZE_OFFSET + 1]   = 0x00;
+    rom_[DESTINATION_OFFSET]    = 0x01;
+
+    std::uint8_t headerChecksum = 0;
+    for (std::size_t i = TITLE_OFFSET; i < HEADER_CHECKSUM_OFFSET; ++i)
+    {
+        headerChecksum = static_cast<std::uint8_t>(headerChecksum - rom_[i] - 1);
+    }
+    rom_[HEADER_CHECKSUM_OFFSET] = headerChecksum;
+
+    // Sum of every byte except the checksum itself, stored big endian
+    std::uint16_t globalChecksum = 0;
+    for (std::size_t i = 0; i < rom_.size(); ++i)
+    {
+        if ((i != GLOBAL_CHECKSUM_OFFSET) && (i != (GLOBAL_CHECKSUM_OFFSET + 1)))
+        {
+            globalChecksum = static_cast<std::uint16_t>(globalChecksum + rom_[i]);
+        }
+    }
+    rom_[GLOBAL_CHECKSUM_OFFSET]     = fxb::getUpper(globalChecksum);
+    rom_[GLOBAL_CHECKSUM_OFFSET + 1] = fxb::getLower(globalChecksum);
+
+    return rom_;
+}
+} // namespace Bench
\ No newline at end of file
@@ -0,0 +1,90 @@
+// Writes the synthetic benchmark roms as .gb files
+//
+// usage: fauxboy_romgen <output_dir> [<workload>...]
+//        fauxboy_romgen --list
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "workloads.hpp"
+
+namespace
+{
+void writeRom(std::filesystem::path const& path, std::vector<std::uint8_t> const& rom)
+{
+    auto ofs = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open())
+    {
+        throw std::runtime_error(std::format("Could not open file: {}", path.c_str()));
+    }
+
+    ofs.write(reinterpret_cast<char const*>(rom.data()), static_cast<std::streamsize>(rom.size()));
+    if (!ofs)
+    {
+        throw std::runtime_error(std::format("Could not write file: {}", path.c_str()));
+    }
+}
+
+int generate(std::filesystem::path const& outputDir, std::vector<std::string_view> const& names)
+{
+    std::vector<Bench::Workload const*> selected;
+    if (names.empty())
+    {
+        for (auto const& workload : Bench::workloads())
+        {
+            selected.push_back(&workload);
+        }
+    }
+    for (auto const name : names)
+    {
+        selected.push_back(&Bench::findWorkload(name));
+    }
+
+    std::filesystem::create_directories(outputDir);
+    for (auto const* workload : selected)
+    {
+        auto const path = (outputDir / std::format("{}.gb", workload->name));
+        auto const rom  = workload->build();
+        writeRom(path, rom);
+        std::cout << std::format("{} ({} KiB)\n", path.c_str(), (rom.size() / 1024));
+    }
+
+    return EXIT_SUCCESS;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if ((argc == 2) && (std::string_view(argv[1]) == "--list"))
+    {
+        for (auto const& workload : Bench::workloads())
+        {
+            std::cout << std::format("{:<14}{}\n", workload.name, workload.description);
+        }
+        return EXIT_SUCCESS;
+    }
+
+    if (argc < 2)
+    {
+        std::cerr << "usage: fauxboy_romgen <output_dir> [<workload>...]\n"
+                     "       fauxboy_romgen --list\n";
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        return generate(argv[1], std::vector<std::string_view>(argv + 2, argv + argc));
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}
\ No newline at end of file
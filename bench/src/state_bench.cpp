@@ -0,0 +1,105 @@
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <fauxboy/cartridge.hpp>
+#include <fauxboy/cpu.hpp>
+#include <fauxboy/flat_bus.hpp>
+#include <fauxboy/game_boy.hpp>
+
+#include "bench.hpp"
+#include "workloads.hpp"
+
+using namespace fxb;
+
+namespace
+{
+// Snapshots and hashes are taken at the end of a frame, a few frames in the state looks like one from a running game
+constexpr int WARM_UP_FRAMES = 60;
+
+struct Machine
+{
+    FlatBus bus;
+    Cpu cpu = Cpu(&bus);
+};
+
+struct GameBoyFixture
+{
+    GameBoy gameBoy;
+    std::vector<std::uint8_t> snapshot;
+
+    GameBoyFixture()
+        : gameBoy(Cartridge(Bench::findWorkload("memcpy").build()))
+    {
+        for (int i = 0; i < WARM_UP_FRAMES; ++i)
+        {
+            gameBoy.runFrame();
+        }
+        gameBoy.save(snapshot);
+    }
+};
+
+Bench::Body saveRestoreCpu()
+{
+    return [machine = std::make_unique<Machine>()](std::uint64_t iterations)
+    {
+        auto& cpu = *Bench::opaque(&machine->cpu);
+
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            auto const state = cpu.state();
+            Bench::doNotOptimize(state);
+            cpu.reset(state);
+        }
+    };
+}
+
+// Into a reused buffer, as run-ahead and the control protocol save every frame
+Bench::Body saveGameBoy()
+{
+    return [fixture = std::make_unique<GameBoyFixture>()](std::uint64_t iterations)
+    {
+        auto& gameBoy = *Bench::opaque(&fixture->gameBoy);
+
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            gameBoy.save(fixture->snapshot);
+            Bench::doNotOptimize(fixture->snapshot.data());
+        }
+    };
+}
+
+// Includes the backup load() takes to stay untouched by a bad snapshot
+Bench::Body loadGameBoy()
+{
+    return [fixture = std::make_unique<GameBoyFixture>()](std::uint64_t iterations)
+    {
+        auto& gameBoy = *Bench::opaque(&fixture->gameBoy);
+
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            gameBoy.load(fixture->snapshot);
+        }
+        Bench::doNotOptimize(gameBoy.cycles());
+    };
+}
+
+// Streamed over the state as the determinism checker does after every frame
+Bench::Body hashGameBoy()
+{
+    return [fixture = std::make_unique<GameBoyFixture>()](std::uint64_t iterations)
+    {
+        auto const& gameBoy = *Bench::opaque(&fixture->gameBoy);
+
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            Bench::doNotOptimize(gameBoy.hash());
+        }
+    };
+}
+
+Bench::Registrar const saveRestoreCpuBenchmark("state/save_restore/cpu", "snapshot", saveRestoreCpu);
+Bench::Registrar const saveGameBoyBenchmark("state/save/game_boy", "snapshot", saveGameBoy);
+Bench::Registrar const loadGameBoyBenchmark("state/load/game_boy", "snapshot", loadGameBoy);
+Bench::Registrar const hashGameBoyBenchmark("state/hash/game_boy", "hash", hashGameBoy);
+} // namespace
\ No newline at end of file
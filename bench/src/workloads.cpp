@@ -0,0 +1,271 @@
+#include "workloads.hpp"
+
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <format>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "rom_builder.hpp"
+
+namespace Bench
+{
+namespace
+{
+using CartridgeType = RomBuilder::CartridgeType;
+
+constexpr std::uint16_t VBLANK_VECTOR = 0x0040;
+constexpr std::uint16_t STAT_VECTOR   = 0x0048;
+
+std::vector<std::uint8_t> buildAlu()
+{
+    RomBuilder rom;
+
+    rom.label("main");
+    rom.emit({
+        0x3E, 0x5A,       // LD A, 0x5A
+        0x01, 0x34, 0x12, // LD BC, 0x1234
+        0x11, 0x78, 0x56, // LD DE, 0x5678
+        0x21, 0xBC, 0x9A, // LD HL, 0x9ABC
+    });
+
+    rom.label("loop");
+    rom.emit({
+        0x80,       // ADD A, B
+        0x89,       // ADC A, C
+        0x92,       // SUB D
+        0x9B,       // SBC A, E
+        0xA4,       // AND H
+        0xAD,       // XOR L
+        0xB0,       // OR B
+        0xB9,       // CP C
+        0x04,       // INC B
+        0x0D,       // DEC C
+        0x14,       // INC D
+        0x1D,       // DEC E
+        0xC6, 0x11, // ADD A, 0x11
+        0xCE, 0x22, // ADC A, 0x22
+        0xD6, 0x33, // SUB 0x33
+        0xEE, 0x44, // XOR 0x44
+        0x27,       // DAA
+        0x2F,       // CPL
+        0x37,       // SCF
+        0x3F,       // CCF
+        0x09,       // ADD HL, BC
+        0x19,       // ADD HL, DE
+        0x07,       // RLCA
+        0x1F,       // RRA
+    });
+    rom.emitRelative(0x18, "loop"); // JR loop
+
+    return rom.build("FXB ALU", CartridgeType::ROM_ONLY);
+}
+
+// Copies 4KiB out of the second bank into work ram over and over
+std::vector<std::uint8_t> buildMemcpy()
+{
+    RomBuilder rom;
+
+    rom.label("main");
+    rom.emit({
+        0x21, 0x00, 0x40, // LD HL, 0x4000
+        0x11, 0x00, 0xC0, // LD DE, 0xC000
+        0x01, 0x00, 0x10, // LD BC, 0x1000
+    });
+
+    rom.label("loop");
+    rom.emit({
+        0x2A, // LD A, (HL+)
+        0x12, // LD (DE), A
+        0x13, // INC DE
+        0x0B, // DEC BC
+        0x78, // LD A, B
+        0xB1, // OR C
+    });
+    rom.emitRelative(0x20, "loop"); // JR NZ, loop
+    rom.emitRelative(0x18, "main"); // JR main
+
+    std::array<std::uint8_t, 0x1000> source;
+    for (std::size_t i = 0; i < source.size(); ++i)
+    {
+        source[i] = static_cast<std::uint8_t>((i * 7) + (i >> 8));
+    }
+    rom.org(0x4000);
+    rom.emit(source);
+
+    return rom.build("FXB MEMCPY", CartridgeType::ROM_ONLY);
+}
+
+std::vector<std::uint8_t> buildCb()
+{
+    RomBuilder rom;
+
+    rom.label("main");
+    rom.emit({0x21, 0x00, 0xC0}); // LD HL, 0xC000
+
+    rom.label("loop");
+    rom.emit({
+        0xCB, 0x37, // SWAP A
+        0xCB, 0x01, // RLC C
+        0xCB, 0x7A, // BIT 7, D
+        0xCB, 0xDB, // SET 3, E
+        0xCB, 0x9B, // RES 3, E
+        0xCB, 0x16, // RL (HL)
+        0xCB, 0x46, // BIT 0, (HL)
+        0xCB, 0xFE, // SET 7, (HL)
+        0xCB, 0x3F, // SRL A
+        0xCB, 0x28, // SRA B
+        0xCB, 0x20, // SLA B
+        0xCB, 0x1A, // RR D
+    });
+    rom.emitRelative(0x18, "loop"); // JR loop
+
+    return rom.build("FXB CB", CartridgeType::ROM_ONLY);
+}
+
+// Switches through the three upper banks of an MBC1 cartridge and reads a tag from each
+std::vector<std::uint8_t> buildBankSwitch()
+{
+    RomBuilder rom(4);
+
+    rom.label("main");
+    for (std::uint8_t bank = 1; bank < 4; ++bank)
+    {
+        rom.emit({
+            0x3E, bank,       // LD A, bank
+            0xEA, 0x00, 0x20, // LD (0x2000), A
+            0xFA, 0x00, 0x40, // LD A, (0x4000)
+            0x80,             // ADD A, B
+            0x47,             // LD B, A
+        });
+    }
+    rom.emitRelative(0x18, "main"); // JR main
+
+    for (std::uint8_t bank = 1; bank < 4; ++bank)
+    {
+        rom.org(0x4000, bank);
+        rom.emit({static_cast<std::uint8_t>(bank * 0x11)});
+    }
+
+    return rom.build("FXB BANKSWITCH", CartridgeType::MBC1);
+}
+
+// Sleeps in HALT between VBlank interrupts, the handler scrolls the background by a frame counter
+std::vector<std::uint8_t> buildHaltVblank()
+{
+    RomBuilder rom;
+
+    rom.org(VBLANK_VECTOR);
+    rom.emitAbsolute(0xC3, "vblank"); // JP vblank
+
+    rom.org(RomBuilder::CODE_START);
+    rom.label("main");
+    rom.emit({
+        0x31, 0xFE, 0xFF, // LD SP, 0xFFFE
+        0x3E, 0x01,       // LD A, 0x01
+        0xE0, 0xFF,       // LDH (IE), A
+        0x3E, 0x91,       // LD A, 0x91
+        0xE0, 0x40,       // LDH (LCDC), A
+        0xFB,             // EI
+    });
+
+    rom.label("loop");
+    rom.emit({
+        0x76,             // HALT
+        0x00,             // NOP
+        0x21, 0x00, 0xC0, // LD HL, 0xC000
+        0x34,             // INC (HL)
+    });
+    rom.emitRelative(0x18, "loop"); // JR loop
+
+    rom.label("vblank");
+    rom.emit({
+        0xF5,             // PUSH AF
+        0xFA, 0x00, 0xC0, // LD A, (0xC000)
+        0xE0, 0x42,       // LDH (SCY), A
+        0xF1,             // POP AF
+        0xD9,             // RETI
+    });
+
+    return rom.build("FXB HALTVBLANK", CartridgeType::ROM_ONLY);
+}
+
+// LY=LYC interrupt every 8 lines, the handler bends the background by writing LY into SCX
+std::vector<std::uint8_t> buildStatRaster()
+{
+    RomBuilder rom;
+
+    rom.org(STAT_VECTOR);
+    rom.emitAbsolute(0xC3, "stat"); // JP stat
+
+    rom.org(RomBuilder::CODE_START);
+    rom.label("main");
+    rom.emit({
+        0x31, 0xFE, 0xFF, // LD SP, 0xFFFE
+        0x3E, 0x40,       // LD A, 0x40
+        0xE0, 0x41,       // LDH (STAT), A
+        0xAF,             // XOR A
+        0xE0, 0x45,       // LDH (LYC), A
+        0x3E, 0x02,       // LD A, 0x02
+        0xE0, 0xFF,       // LDH (IE), A
+        0x3E, 0x91,       // LD A, 0x91
+        0xE0, 0x40,       // LDH (LCDC), A
+        0xFB,             // EI
+    });
+
+    rom.label("loop");
+    rom.emit({
+        0x76, // HALT
+        0x00, // NOP
+    });
+    rom.emitRelative(0x18, "loop"); // JR loop
+
+    rom.label("stat");
+    rom.emit({
+        0xF5,       // PUSH AF
+        0xF0, 0x44, // LDH A, (LY)
+        0xE0, 0x43, // LDH (SCX), A
+        0xF0, 0x45, // LDH A, (LYC)
+        0xC6, 0x08, // ADD A, 0x08
+        0xFE, 0x90, // CP 144
+    });
+    rom.emitRelative(0x38, "stat_store"); // JR C, stat_store
+    rom.emit({0xAF});                     // XOR A
+
+    rom.label("stat_store");
+    rom.emit({
+        0xE0, 0x45, // LDH (LYC), A
+        0xF1,       // POP AF
+        0xD9,       // RETI
+    });
+
+    return rom.build("FXB STATRASTER", CartridgeType::ROM_ONLY);
+}
+
+constexpr auto WORKLOADS = std::to_array<Workload>({
+    {.name = "alu", .description = "8 and 16-bit arithmetic on registers", .build = buildAlu},
+    {.name = "memcpy", .description = "4KiB copy from rom to work ram", .build = buildMemcpy},
+    {.name = "cb", .description = "CB prefixed bit operations on registers and (HL)", .build = buildCb},
+    {.name = "bank_switch", .description = "MBC1 bank switches with a read after each", .build = buildBankSwitch},
+    {.name = "halt_vblank", .description = "HALT until the VBlank interrupt", .build = buildHaltVblank},
+    {.name = "stat_raster", .description = "LY=LYC STAT interrupt every 8 lines", .build = buildStatRaster},
+});
+} // namespace
+
+std::span<Workload const> workloads() noexcept
+{
+    return WORKLOADS;
+}
+
+Workload const& findWorkload(std::string_view name)
+{
+    auto const itr = std::ranges::find(WORKLOADS, name, &Workload::name);
+    if (itr == WORKLOADS.end())
+    {
+        throw std::invalid_argument(std::format("Unknown workload: {}", name));
+    }
+    return *itr;
+}
+} // namespace Bench
\ No newline at end of file
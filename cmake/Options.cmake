@@ -6,7 +6,24 @@ option(BUILD_TESTING "Build tests" OFF)
 set(FAUXBOY_BUILD_TESTS "${BUILD_TESTING}")
 mark_as_advanced(FAUXBOY_BUILD_TESTS)
 
+option(BUILD_TOOLS "Build tools" OFF)
+set(FAUXBOY_BUILD_TOOLS "${BUILD_TOOLS}")
+mark_as_advanced(FAUXBOY_BUILD_TOOLS)
+
+option(BUILD_BENCHMARKS "Build benchmarks" OFF)
+set(FAUXBOY_BUILD_BENCHMARKS "${BUILD_BENCHMARKS}")
+mark_as_advanced(FAUXBOY_BUILD_BENCHMARKS)
+
 set(FAUXBOY_BUILD_TYPE STATIC)
 if (FAUXBOY_BUILD_SHARED)
     set(FAUXBOY_BUILD_TYPE SHARED)
-endif ()
\ No newline at end of file
+endif ()
+
+set(PGO "OFF" CACHE STRING "Profile guided optimisation of the library: OFF, GENERATE or USE")
+set_property(CACHE PGO PROPERTY STRINGS OFF GENERATE USE)
+set(FAUXBOY_PGO "${PGO}")
+mark_as_advanced(FAUXBOY_PGO)
+
+set(PGO_DIR "${PROJECT_SOURCE_DIR}/build/pgo" CACHE PATH "Directory the PGO profiles are written to and read from")
+set(FAUXBOY_PGO_DIR "${PGO_DIR}")
+mark_as_advanced(FAUXBOY_PGO_DIR)
\ No newline at end of file
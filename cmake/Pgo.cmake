@@ -0,0 +1,46 @@
+# Profile guided optimisation, a GENERATE build writes profiles to FAUXBOY_PGO_DIR while its executables run and a USE
+# build of the same sources reads them back, only the library itself is instrumented
+
+if (FAUXBOY_PGO STREQUAL "OFF")
+    return()
+endif ()
+
+if (NOT FAUXBOY_PGO MATCHES "^(GENERATE|USE)$")
+    message(FATAL_ERROR "PGO has to be OFF, GENERATE or USE, got ${FAUXBOY_PGO}")
+endif ()
+
+if (CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+    # Profiles are named after the object files relative to the build directory so a USE build in another directory
+    # finds them, code the training never reached is still optimised as usual
+    set(FAUXBOY_PGO_GENERATE_FLAGS "-fprofile-generate=${FAUXBOY_PGO_DIR}" "-fprofile-prefix-path=${CMAKE_BINARY_DIR}")
+    set(FAUXBOY_PGO_USE_FLAGS
+        "-fprofile-use=${FAUXBOY_PGO_DIR}"
+        "-fprofile-prefix-path=${CMAKE_BINARY_DIR}"
+        "-fprofile-partial-training"
+        "-Wmissing-profile"
+    )
+elseif (CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+    # Raw profiles have to be merged with llvm-profdata before they can be used
+    set(FAUXBOY_PGO_PROFDATA "${FAUXBOY_PGO_DIR}/fauxboy.profdata")
+    set(FAUXBOY_PGO_GENERATE_FLAGS "-fprofile-generate=${FAUXBOY_PGO_DIR}")
+    set(FAUXBOY_PGO_USE_FLAGS "-fprofile-use=${FAUXBOY_PGO_PROFDATA}" "-Wno-profile-instr-unprofiled")
+
+    get_filename_component(FAUXBOY_COMPILER_DIR "${CMAKE_CXX_COMPILER}" DIRECTORY)
+    find_program(LLVM_PROFDATA NAMES llvm-profdata HINTS "${FAUXBOY_COMPILER_DIR}" REQUIRED)
+else ()
+    message(FATAL_ERROR "PGO is only supported with GCC and Clang")
+endif ()
+
+if ((FAUXBOY_PGO STREQUAL "USE") AND NOT EXISTS "${FAUXBOY_PGO_DIR}")
+    message(FATAL_ERROR "No profiles in ${FAUXBOY_PGO_DIR}, build and run fauxboy_pgo_train with PGO=GENERATE first")
+endif ()
+
+function(fauxboy_target_pgo target)
+    if (FAUXBOY_PGO STREQUAL "GENERATE")
+        target_compile_options(${target} PRIVATE ${FAUXBOY_PGO_GENERATE_FLAGS})
+        # The instrumentation runtime has to be linked into everything using the library
+        target_link_options(${target} PUBLIC "-fprofile-generate=${FAUXBOY_PGO_DIR}")
+    else ()
+        target_compile_options(${target} PRIVATE ${FAUXBOY_PGO_USE_FLAGS})
+    endif ()
+endfunction()
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef FAUXBOY_ABI_HPP
+#define FAUXBOY_ABI_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+#include "cpu.hpp"
+#include "recording_bus.hpp"
+
+// Unmangled entry points so tools can dlopen several builds of the library side by side and drive them through the
+// same interface. fxb_machine is a Cpu on top of a RecordingBus and fxb_game_boy a whole GameBoy. Bump the version
+// whenever an entry point is added or changes so a tool never mixes builds that expose different sets
+inline constexpr std::uint32_t FXB_ABI_VERSION = 3;
+inline constexpr std::uint32_t FXB_MEMORY_SIZE = 0x10000;
+
+extern "C"
+{
+enum fxb_status : std::int32_t
+{
+    FXB_OK             = 0,
+    FXB_ILLEGAL_OPCODE = 1,
+    FXB_ERROR          = 2
+};
+
+struct fxb_machine;
+
+std::uint32_t fxb_abi_version() noexcept;
+
+fxb_machine* fxb_create() noexcept;
+void fxb_destroy(fxb_machine* machine) noexcept;
+
+// memory points to FXB_MEMORY_SIZE bytes
+void fxb_load(fxb_machine* machine, fxb::CpuState const* state, std::uint8_t const* memory) noexcept;
+void fxb_save(fxb_machine const* machine, fxb::CpuState* state, std::uint8_t* memory) noexcept;
+
+// Stops at the first instruction that throws, executed receives the number of instructions that completed
+fxb_status fxb_step(fxb_machine* machine, std::uint64_t count, std::uint64_t* executed) noexcept;
+
+// M-cycles since the last fxb_load
+std::uint64_t fxb_cycles(fxb_machine const* machine) noexcept;
+
+// Bus activity of the last instruction fxb_step executed, one entry per m-cycle. Copies at most capacity entries and
+// returns the number of m-cycles the instruction took
+std::size_t fxb_bus_log(fxb_machine const* machine, fxb::BusCycle* log, std::size_t capacity) noexcept;
+
+struct fxb_game_boy;
+
+// Starts at 0x0100 without a boot rom, null when the image is not a cartridge this build can run
+fxb_game_boy* fxb_game_boy_create(std::uint8_t const* rom, std::size_t size) noexcept;
+void fxb_game_boy_destroy(fxb_game_boy* gameBoy) noexcept;
+
+// Mmu::BUTTON_* bits of the buttons held down
+void fxb_game_boy_set_buttons(fxb_game_boy* gameBoy, std::uint8_t pressed) noexcept;
+
+fxb_status fxb_game_boy_run_frame(fxb_game_boy* gameBoy) noexcept;
+// Stops at the first instruction that throws, executed receives the number of instructions that completed
+fxb_status fxb_game_boy_step(fxb_game_boy* gameBoy, std::uint64_t count, std::uint64_t* executed) noexcept;
+
+std::uint64_t fxb_game_boy_hash(fxb_game_boy const* gameBoy) noexcept;
+std::uint64_t fxb_game_boy_cycles(fxb_game_boy const* gameBoy) noexcept;
+void fxb_game_boy_cpu_state(fxb_game_boy const* gameBoy, fxb::CpuState* state) noexcept;
+
+// Copies the snapshot into buffer when it fits and returns its size either way, 0 when it could not be taken
+std::size_t fxb_game_boy_save(fxb_game_boy const* gameBoy, std::uint8_t* buffer, std::size_t capacity) noexcept;
+// Leaves the machine untouched unless it returns FXB_OK
+fxb_status fxb_game_boy_load(fxb_game_boy* gameBoy, std::uint8_t const* snapshot, std::size_t size) noexcept;
+}
+
+#endif // FAUXBOY_ABI_HPP
\ No newline at end of file
@@ -34,6 +34,9 @@ public:
 
     virtual std::uint8_t read(Address address)              = 0;
     virtual void write(Address address, std::uint8_t value) = 0;
+
+    // Called when the cpu executes STOP, a CGB memory map switches speeds here
+    virtual void stop() {}
 };
 } // namespace fxb
 
@@ -0,0 +1,90 @@
+#ifndef FAUXBOY_CARTRIDGE_HPP
+#define FAUXBOY_CARTRIDGE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "address.hpp"
+#include "snapshot.hpp"
+
+namespace fxb
+{
+class BadCartridgeException : public std::runtime_error
+{
+public:
+    explicit BadCartridgeException(std::string const& reason)
+        : std::runtime_error(reason)
+    {
+    }
+};
+
+enum class MemoryBankController : std::uint8_t
+{
+    NONE,
+    MBC1,
+    MBC5
+};
+
+// ROM and external RAM of a cartridge along with the banking registers of its controller, the currently selected banks
+// are handed out as spans so the memory map can point straight into them. Copies share the immutable ROM
+class Cartridge
+{
+public:
+    static constexpr std::size_t ROM_BANK_SIZE = 0x4000;
+    static constexpr std::size_t RAM_BANK_SIZE = 0x2000;
+
+private:
+    std::shared_ptr<std::vector<std::uint8_t> const> rom_;
+    std::vector<std::uint8_t> ram_;
+    std::string title_;
+    MemoryBankController controller_;
+    bool supportsCgb_;
+
+    std::uint16_t romBankLow_ = 1;
+    std::uint8_t romBankHigh_ = 0;
+    std::uint8_t ramBank_     = 0;
+    bool ramEnabled_          = false;
+    bool advancedBankingMode_ = false;
+
+private:
+    [[nodiscard]] std::size_t romBankCount() const noexcept { return (rom_->size() / ROM_BANK_SIZE); }
+    [[nodiscard]] std::size_t ramBankCount() const noexcept { return (ram_.size() / RAM_BANK_SIZE); }
+
+    [[nodiscard]] std::size_t lowerRomBankIndex() const noexcept;
+    [[nodiscard]] std::size_t upperRomBankIndex() const noexcept;
+    [[nodiscard]] std::size_t ramBankIndex() const noexcept;
+
+public:
+    // Throws BadCartridgeException when the header is truncated or names an unsupported controller
+    explicit Cartridge(std::vector<std::uint8_t> rom);
+
+    [[nodiscard]] static Cartridge load(std::filesystem::path const& path);
+
+    [[nodiscard]] std::string const& title() const noexcept { return title_; }
+    [[nodiscard]] MemoryBankController controller() const noexcept { return controller_; }
+    // Header flag of games with CGB features, both CGB only and DMG compatible ones
+    [[nodiscard]] bool supportsCgb() const noexcept { return supportsCgb_; }
+
+    // 0x0000-0x3FFF and 0x4000-0x7FFF
+    [[nodiscard]] std::span<std::uint8_t const, ROM_BANK_SIZE> lowerRomBank() const noexcept;
+    [[nodiscard]] std::span<std::uint8_t const, ROM_BANK_SIZE> upperRomBank() const noexcept;
+
+    // 0xA000-0xBFFF, empty while the RAM is disabled or missing
+    [[nodiscard]] std::span<std::uint8_t> ramBank() noexcept;
+
+    // Writes to 0x0000-0x7FFF, the selected banks may change afterwards
+    void writeControl(Address address, std::uint8_t value) noexcept;
+
+    // External RAM and banking registers, the rom itself is not part of a snapshot
+    void save(SnapshotWriter& writer) const;
+    void load(SnapshotReader& reader);
+};
+} // namespace fxb
+
+#endif // FAUXBOY_CARTRIDGE_HPP
\ No newline at end of file
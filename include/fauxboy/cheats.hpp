@@ -0,0 +1,39 @@
+#ifndef FAUXBOY_CHEATS_HPP
+#define FAUXBOY_CHEATS_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace fxb
+{
+// Replaces a byte of the rom as seen by the cpu, only in banks where the original byte equals compare if given
+struct RomPatch
+{
+    std::uint16_t address = 0;
+    std::uint8_t value    = 0;
+    std::optional<std::uint8_t> compare;
+
+    [[nodiscard]] bool operator==(RomPatch const&) const = default;
+};
+
+// Written to memory at the start of every VBlank, a WRAM bank pins 0xD000-0xDFFF writes to that bank
+struct RamPoke
+{
+    std::uint16_t address = 0;
+    std::uint8_t value    = 0;
+    std::optional<std::uint8_t> wramBank;
+
+    [[nodiscard]] bool operator==(RamPoke const&) const = default;
+};
+
+// ABC-DEF or ABC-DEF-GHI, the dashes are optional. Throws std::invalid_argument for malformed codes and addresses
+// outside the rom
+[[nodiscard]] RomPatch parseGameGenie(std::string_view code);
+
+// TTVVAAAA with the address in little endian, type 01 writes the current bank and 90-97 a fixed WRAM bank. Throws
+// std::invalid_argument for malformed codes and addresses outside cartridge RAM, WRAM and HRAM
+[[nodiscard]] RamPoke parseGameShark(std::string_view code);
+} // namespace fxb
+
+#endif // FAUXBOY_CHEATS_HPP
\ No newline at end of file
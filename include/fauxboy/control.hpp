@@ -0,0 +1,72 @@
+#ifndef FAUXBOY_CONTROL_HPP
+#define FAUXBOY_CONTROL_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "game_boy.hpp"
+
+namespace fxb
+{
+// Binary protocol orchestrators use to drive a headless instance. All integers are little endian. A batch is a u32
+// length followed by that many bytes of commands, each command is
+//
+//     u8 command, u32 payload length, payload
+//
+// and the reply batch has the same framing with one entry per executed command
+//
+//     u8 status, u32 data length, data
+//
+// Commands run in order and a batch stops after the first one that fails, its reply carries the error message
+enum class ControlCommand : std::uint8_t
+{
+    // Payload is the rom image
+    LOAD = 1,
+    // Payload is a u32 frame count, replies with the u64 m-cycle count since power on
+    STEP_FRAMES = 2,
+    // Payload is a u8 mask of Mmu::BUTTON_* bits
+    SET_BUTTONS = 3,
+    // Payload is a u16 address and a u32 length, the range must not wrap around
+    READ_MEMORY = 4,
+    // Replies with a snapshot as GameBoy::save() produces it
+    SAVE_STATE = 5,
+    // Payload is a snapshot
+    LOAD_STATE = 6,
+    // Replies with SCREEN_PIXELS host colors
+    GET_FRAMEBUFFER = 7
+};
+
+enum class ControlStatus : std::uint8_t
+{
+    OK          = 0,
+    ERROR       = 1,
+    UNSUPPORTED = 2
+};
+
+class ControlSession
+{
+public:
+    // Large enough for a rom of the biggest MBC5 cartridge along with its snapshot
+    static constexpr std::size_t MAX_BATCH_SIZE = (64 * 1024 * 1024);
+
+    static constexpr std::size_t COMMAND_HEADER_SIZE = 5;
+
+private:
+    std::unique_ptr<GameBoy> gameBoy_;
+
+private:
+    [[nodiscard]] GameBoy& gameBoy();
+    [[nodiscard]] ControlStatus execute(ControlCommand command,
+                                        std::span<std::uint8_t const> payload,
+                                        std::vector<std::uint8_t>& data);
+
+public:
+    // Runs the commands of one batch, without its length prefix, and appends their replies
+    void handle(std::span<std::uint8_t const> batch, std::vector<std::uint8_t>& replies);
+};
+} // namespace fxb
+
+#endif // FAUXBOY_CONTROL_HPP
\ No newline at end of file
@@ -190,6 +190,9 @@ public:
 
     void setOnTickCallback(OnTickCallback callback);
 
+    // Snapshot of the register file, pairs with reset() to save and restore the cpu
+    [[nodiscard]] CpuState state() const noexcept;
+
     void reset(CpuState const& state = {});
 
     void step();
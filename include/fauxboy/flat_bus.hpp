@@ -0,0 +1,33 @@
+#ifndef FAUXBOY_FLAT_BUS_HPP
+#define FAUXBOY_FLAT_BUS_HPP
+
+#include <cstdint>
+#include <array>
+#include <span>
+
+#include "address.hpp"
+#include "bus.hpp"
+
+namespace fxb
+{
+// Plain 64KiB of RAM without any memory map, every address is readable and writable
+class FlatBus : public Bus
+{
+public:
+    static constexpr std::size_t SIZE = 0x10000;
+
+private:
+    std::array<std::uint8_t, SIZE> memory_ = {};
+
+public:
+    [[nodiscard]] std::span<std::uint8_t, SIZE> memory() noexcept { return memory_; }
+    [[nodiscard]] std::span<std::uint8_t const, SIZE> memory() const noexcept { return memory_; }
+
+    void reset() noexcept { memory_.fill(0); }
+
+    [[nodiscard]] std::uint8_t read(Address address) override { return memory_[address.value]; }
+    void write(Address address, std::uint8_t value) override { memory_[address.value] = value; }
+};
+} // namespace fxb
+
+#endif // FAUXBOY_FLAT_BUS_HPP
\ No newline at end of file
@@ -0,0 +1,46 @@
+#ifndef FAUXBOY_FRAME_HPP
+#define FAUXBOY_FRAME_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <span>
+
+#include "palette.hpp"
+
+namespace fxb
+{
+inline constexpr std::size_t SCREEN_WIDTH  = 160;
+inline constexpr std::size_t SCREEN_HEIGHT = 144;
+inline constexpr std::size_t SCREEN_PIXELS = (SCREEN_WIDTH * SCREEN_HEIGHT);
+
+// A frame as the LCD draws it, every pixel is an index into the host color table of the palette RAM so the
+// conversion to host colors happens once per palette write instead of once per pixel
+struct IndexedFramebuffer
+{
+    std::array<std::uint8_t, SCREEN_PIXELS> pixels = {};
+
+    [[nodiscard]] std::uint8_t& at(std::size_t x, std::size_t y) noexcept { return pixels[(y * SCREEN_WIDTH) + x]; }
+    [[nodiscard]] std::uint8_t at(std::size_t x, std::size_t y) const noexcept
+    {
+        return pixels[(y * SCREEN_WIDTH) + x];
+    }
+};
+
+using HostFramebuffer = std::array<HostColor, SCREEN_PIXELS>;
+
+// One table load per pixel, indices are masked so a stray value can never read past the table
+inline void resolve(IndexedFramebuffer const& frame,
+                    std::span<HostColor const, PaletteRam::HOST_COLORS> colors,
+                    std::span<HostColor, SCREEN_PIXELS> output) noexcept
+{
+    static_assert(PaletteRam::HOST_COLORS == 64);
+
+    for (std::size_t i = 0; i < SCREEN_PIXELS; ++i)
+    {
+        output[i] = colors[frame.pixels[i] & 0x3F];
+    }
+}
+} // namespace fxb
+
+#endif // FAUXBOY_FRAME_HPP
\ No newline at end of file
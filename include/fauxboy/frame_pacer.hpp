@@ -0,0 +1,90 @@
+#ifndef FAUXBOY_FRAME_PACER_HPP
+#define FAUXBOY_FRAME_PACER_HPP
+
+#include <cstdint>
+#include <chrono>
+#include <functional>
+
+namespace fxb
+{
+// Keeps an interactive instance at the refresh rate of the LCD. Waiting sleeps on an absolute deadline until shortly
+// before it and spins for the rest, a plain sleep overshoots by up to a scheduler tick while spinning the whole frame
+// burns a core. A host that falls behind skips rendering, a host that falls far behind gives up on catching up
+//
+//     gameBoy.runFrame();
+//     if (pacer.shouldRender())
+//     {
+//         draw();
+//     }
+//     pacer.wait();
+class FramePacer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // 4194304 Hz / 70224 cycles per frame
+    static constexpr double FRAME_RATE = (4'194'304.0 / 70'224.0);
+
+    // Frames in a row that may go undrawn before one gets drawn regardless
+    static constexpr std::uint32_t MAX_SKIPPED_FRAMES = 4;
+    // Lagging by more frames than this moves the schedule to now instead of running fast to catch up
+    static constexpr std::uint32_t MAX_LAG_FRAMES = 8;
+
+    // Where the pacer reads the time and how it sleeps, the default is the steady clock and an absolute sleep on it.
+    // Tests swap in a clock they advance themselves
+    struct Timer
+    {
+        std::function<Clock::time_point()> now;
+        std::function<void(Clock::time_point deadline)> sleepUntil;
+    };
+
+    struct Statistics
+    {
+        std::uint64_t frames        = 0;
+        // Calls to wait() that came in after the deadline and so had nothing to wait for
+        std::uint64_t lateFrames    = 0;
+        std::uint64_t skippedFrames = 0;
+        std::uint64_t resyncs       = 0;
+        // How late wait() woke up after the deadline, only counting calls that slept or spun
+        std::chrono::nanoseconds totalJitter = {};
+        std::chrono::nanoseconds maxJitter   = {};
+
+        [[nodiscard]] std::chrono::nanoseconds meanJitter() const noexcept
+        {
+            auto const waited = static_cast<std::int64_t>(frames - lateFrames);
+            return ((waited > 0) ? (totalJitter / waited) : std::chrono::nanoseconds());
+        }
+    };
+
+private:
+    Timer timer_;
+    Clock::duration spinWindow_;
+    double speed_ = 1.0;
+    Clock::duration period_;
+    Clock::time_point deadline_;
+    std::uint32_t skippedInRow_ = 0;
+    Statistics statistics_;
+
+public:
+    // The spin window covers the wakeup latency of the host, a millisecond suits most kernels
+    explicit FramePacer(Clock::duration spinWindow = std::chrono::milliseconds(1), Timer timer = systemTimer());
+
+    [[nodiscard]] static Timer systemTimer();
+
+    [[nodiscard]] double speed() const noexcept { return speed_; }
+    // Fast forward above 1, slow motion below, the schedule restarts from now. Throws std::invalid_argument unless
+    // the multiplier is positive
+    void setSpeed(double multiplier);
+
+    // Whether the frame that was just emulated should be drawn, false while the schedule is behind
+    [[nodiscard]] bool shouldRender() noexcept;
+
+    // Blocks until the end of the current frame slot
+    void wait() noexcept;
+
+    [[nodiscard]] Statistics const& statistics() const noexcept { return statistics_; }
+    void resetStatistics() noexcept { statistics_ = {}; }
+};
+} // namespace fxb
+
+#endif // FAUXBOY_FRAME_PACER_HPP
\ No newline at end of file
@@ -0,0 +1,68 @@
+#ifndef FAUXBOY_GAME_BOY_HPP
+#define FAUXBOY_GAME_BOY_HPP
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "cartridge.hpp"
+#include "cpu.hpp"
+#include "mmu.hpp"
+#include "snapshot.hpp"
+
+namespace fxb
+{
+// Cpu and memory map of a DMG or CGB driven together, the clock counts cpu m-cycles since power on so it runs twice as
+// fast in double speed mode
+class GameBoy
+{
+    friend class InstanceTemplate;
+    friend class RunAhead;
+
+public:
+    // At single speed
+    static constexpr std::uint64_t M_CYCLES_PER_FRAME = (Mmu::M_CYCLES_PER_LINE * Mmu::LINES_PER_FRAME);
+
+private:
+    Mmu mmu_;
+    Cpu cpu_              = Cpu(&mmu_);
+    std::uint64_t cycles_ = 0;
+
+private:
+    void save(SnapshotWriter& writer) const;
+    void restore(std::span<std::uint8_t const> snapshot);
+
+public:
+    // Starts at 0x0100 with the registers and I/O in the state the boot ROM leaves behind
+    explicit GameBoy(Cartridge cartridge);
+    // Runs the boot ROM from 0x0000 first, 256 bytes for a DMG and 2304 for a CGB
+    GameBoy(Cartridge cartridge, std::vector<std::uint8_t> bootRom);
+
+    GameBoy(GameBoy const&)            = delete;
+    GameBoy& operator=(GameBoy const&) = delete;
+
+    [[nodiscard]] Cpu& cpu() noexcept { return cpu_; }
+    [[nodiscard]] Cpu const& cpu() const noexcept { return cpu_; }
+    [[nodiscard]] Mmu& mmu() noexcept { return mmu_; }
+    [[nodiscard]] Mmu const& mmu() const noexcept { return mmu_; }
+
+    [[nodiscard]] std::uint64_t cycles() const noexcept { return cycles_; }
+
+    // Executes one instruction along with any HDMA transfer it started
+    void step();
+
+    // Runs until the LCD finishes the current frame, the last instruction may overshoot it
+    void runFrame();
+
+    [[nodiscard]] std::vector<std::uint8_t> save() const;
+    // Replaces the contents of the snapshot, a buffer that is saved into every frame only allocates the first time
+    void save(std::vector<std::uint8_t>& snapshot) const;
+    // Hash of everything a snapshot holds, two machines that hash the same at the end of a frame run on identically.
+    // Walks the state without building a snapshot, equal to hashBytes(save())
+    [[nodiscard]] std::uint64_t hash() const;
+    // Throws BadSnapshotException for a truncated or foreign snapshot and leaves the machine untouched then
+    void load(std::span<std::uint8_t const> snapshot);
+};
+} // namespace fxb
+
+#endif // FAUXBOY_GAME_BOY_HPP
\ No newline at end of file
@@ -0,0 +1,245 @@
+#ifndef FAUXBOY_HASH_HPP
+#define FAUXBOY_HASH_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <span>
+#include <type_traits>
+
+#include "cpu.hpp"
+
+namespace fxb
+{
+namespace detail
+{
+inline constexpr std::uint64_t HASH_PRIME_1 = 0x9E3779B185EBCA87ull;
+inline constexpr std::uint64_t HASH_PRIME_2 = 0xC2B2AE3D27D4EB4Full;
+inline constexpr std::uint64_t HASH_PRIME_3 = 0x165667B19E3779F9ull;
+inline constexpr std::uint64_t HASH_PRIME_4 = 0x85EBCA77C2B2AE63ull;
+inline constexpr std::uint64_t HASH_PRIME_5 = 0x27D4EB2F165667C5ull;
+
+[[nodiscard]] inline std::uint64_t load64(std::uint8_t const* bytes) noexcept
+{
+    std::uint64_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+[[nodiscard]] inline std::uint32_t load32(std::uint8_t const* bytes) noexcept
+{
+    std::uint32_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+[[nodiscard]] inline constexpr std::uint64_t hashRound(std::uint64_t acc, std::uint64_t input) noexcept
+{
+    acc += (input * HASH_PRIME_2);
+    acc = std::rotl(acc, 31);
+    return (acc * HASH_PRIME_1);
+}
+
+[[nodiscard]] inline constexpr std::uint64_t hashMergeRound(std::uint64_t acc, std::uint64_t lane) noexcept
+{
+    acc ^= hashRound(0, lane);
+    return ((acc * HASH_PRIME_1) + HASH_PRIME_4);
+}
+
+[[nodiscard]] inline std::uint64_t hashMergeLanes(std::array<std::uint64_t, 4> const& lanes) noexcept
+{
+    auto hash = (std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18));
+    for (auto const lane : lanes)
+    {
+        hash = hashMergeRound(hash, lane);
+    }
+    return hash;
+}
+
+// Folds in the last bytes that do not fill a stripe and mixes the result
+[[nodiscard]] inline std::uint64_t hashFinish(std::uint64_t hash,
+                                              std::uint8_t const* data,
+                                              std::uint8_t const* end) noexcept
+{
+    for (; (data + 8) <= end; data += 8)
+    {
+        hash ^= hashRound(0, load64(data));
+        hash = ((std::rotl(hash, 27) * HASH_PRIME_1) + HASH_PRIME_4);
+    }
+
+    if ((data + 4) <= end)
+    {
+        hash ^= (load32(data) * HASH_PRIME_1);
+        hash = ((std::rotl(hash, 23) * HASH_PRIME_2) + HASH_PRIME_3);
+        data += 4;
+    }
+
+    for (; data < end; ++data)
+    {
+        hash ^= (*data * HASH_PRIME_5);
+        hash = (std::rotl(hash, 11) * HASH_PRIME_1);
+    }
+
+    hash ^= (hash >> 33);
+    hash *= HASH_PRIME_2;
+    hash ^= (hash >> 29);
+    hash *= HASH_PRIME_3;
+    hash ^= (hash >> 32);
+
+    return hash;
+}
+} // namespace detail
+
+// XXH64, the input is consumed in 32 byte stripes over four independent lanes so the bulk of a memory image is hashed
+// without any dependency between neighbouring words, words are loaded in host byte order
+[[nodiscard]] inline std::uint64_t hashBytes(std::span<std::uint8_t const> bytes, std::uint64_t seed = 0) noexcept
+{
+    using namespace detail;
+
+    auto const* data = bytes.data();
+    auto const size  = bytes.size();
+    auto const* end  = (data + size);
+
+    std::uint64_t hash;
+
+    if (size >= 32)
+    {
+        std::array<std::uint64_t, 4> lanes = {
+            (seed + HASH_PRIME_1 + HASH_PRIME_2),
+            (seed + HASH_PRIME_2),
+            seed,
+            (seed - HASH_PRIME_1),
+        };
+
+        auto const* const lastStripe = (end - 32);
+        for (; data <= lastStripe; data += 32)
+        {
+            for (std::size_t lane = 0; lane < lanes.size(); ++lane)
+            {
+                lanes[lane] = hashRound(lanes[lane], load64(data + (lane * 8)));
+            }
+        }
+
+        hash = hashMergeLanes(lanes);
+    }
+    else
+    {
+        hash = (seed + HASH_PRIME_5);
+    }
+
+    return hashFinish((hash + size), data, end);
+}
+
+// XXH64 over input that arrives in pieces, hashes the same as hashBytes() over all of it joined together. Nothing is
+// allocated, at most one stripe is buffered between calls
+class HashStream
+{
+private:
+    std::array<std::uint64_t, 4> lanes_;
+    std::array<std::uint8_t, 32> stripe_ = {};
+    std::size_t buffered_                = 0;
+    std::uint64_t size_                  = 0;
+    std::uint64_t seed_;
+
+    void consume(std::uint8_t const* stripe) noexcept
+    {
+        for (std::size_t lane = 0; lane < lanes_.size(); ++lane)
+        {
+            lanes_[lane] = detail::hashRound(lanes_[lane], detail::load64(stripe + (lane * 8)));
+        }
+    }
+
+public:
+    explicit HashStream(std::uint64_t seed = 0) noexcept
+        : lanes_({(seed + detail::HASH_PRIME_1 + detail::HASH_PRIME_2),
+                  (seed + detail::HASH_PRIME_2),
+                  seed,
+                  (seed - detail::HASH_PRIME_1)}),
+          seed_(seed)
+    {
+    }
+
+    void update(std::span<std::uint8_t const> bytes) noexcept
+    {
+        if (bytes.empty())
+        {
+            return;
+        }
+
+        auto const* data = bytes.data();
+        auto const* end  = (data + bytes.size());
+        size_ += bytes.size();
+
+        // Tops up a stripe left over from the last call first
+        if (buffered_ > 0)
+        {
+            auto const count = std::min<std::size_t>((stripe_.size() - buffered_), bytes.size());
+            std::memcpy((stripe_.data() + buffered_), data, count);
+            buffered_ += count;
+            data += count;
+            if (buffered_ < stripe_.size())
+            {
+                return;
+            }
+            consume(stripe_.data());
+            buffered_ = 0;
+        }
+
+        for (; (end - data) >= 32; data += 32)
+        {
+            consume(data);
+        }
+
+        buffered_ = static_cast<std::size_t>(end - data);
+        if (buffered_ > 0)
+        {
+            std::memcpy(stripe_.data(), data, buffered_);
+        }
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void update(T const& value) noexcept
+    {
+        update(std::span(reinterpret_cast<std::uint8_t const*>(&value), sizeof(T)));
+    }
+
+    // The stream can take more input afterwards
+    [[nodiscard]] std::uint64_t digest() const noexcept
+    {
+        auto const hash = ((size_ >= 32) ? detail::hashMergeLanes(lanes_) : (seed_ + detail::HASH_PRIME_5));
+        return detail::hashFinish((hash + size_), stripe_.data(), (stripe_.data() + buffered_));
+    }
+};
+
+// Registers are serialised field by field so padding in CpuState never leaks into the hash
+[[nodiscard]] inline std::uint64_t hashState(CpuState const& state, std::uint64_t seed = 0) noexcept
+{
+    std::array<std::uint8_t, 12> const bytes = {
+        state.A,
+        state.B,
+        state.C,
+        state.D,
+        state.E,
+        state.F,
+        state.H,
+        state.L,
+        getLower(state.SP),
+        getUpper(state.SP),
+        getLower(state.PC),
+        getUpper(state.PC),
+    };
+    return hashBytes(bytes, seed);
+}
+
+// Hash of the whole machine, the registers seed the hash of the memory behind the bus
+[[nodiscard]] inline std::uint64_t hashState(CpuState const& state, std::span<std::uint8_t const> memory) noexcept
+{
+    return hashBytes(memory, hashState(state));
+}
+} // namespace fxb
+
+#endif // FAUXBOY_HASH_HPP
\ No newline at end of file
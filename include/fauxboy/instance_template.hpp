@@ -0,0 +1,38 @@
+#ifndef FAUXBOY_INSTANCE_TEMPLATE_HPP
+#define FAUXBOY_INSTANCE_TEMPLATE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "cartridge.hpp"
+#include "cheats.hpp"
+#include "game_boy.hpp"
+
+namespace fxb
+{
+// A machine frozen at some point, for example past the title screen, that any number of new instances start from
+// without emulating their way there again. The rom is shared by the source, the template and every instance, so an
+// instance only costs its own copy of the mutable state. Cheats active on the source stay active on every instance
+// even though snapshots leave them out
+class InstanceTemplate
+{
+private:
+    Cartridge cartridge_;
+    std::vector<std::uint8_t> bootRom_;
+    std::vector<std::uint8_t> snapshot_;
+    std::vector<RomPatch> romPatches_;
+    std::vector<RamPoke> ramPokes_;
+
+public:
+    explicit InstanceTemplate(GameBoy const& source);
+
+    // The instance behaves exactly as the source would have from the point the template was taken
+    [[nodiscard]] std::unique_ptr<GameBoy> spawn() const;
+
+    [[nodiscard]] std::span<std::uint8_t const> snapshot() const noexcept { return snapshot_; }
+};
+} // namespace fxb
+
+#endif // FAUXBOY_INSTANCE_TEMPLATE_HPP
\ No newline at end of file
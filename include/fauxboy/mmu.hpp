@@ -0,0 +1,209 @@
+#ifndef FAUXBOY_MMU_HPP
+#define FAUXBOY_MMU_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <functional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "address.hpp"
+#include "bus.hpp"
+#include "cartridge.hpp"
+#include "cheats.hpp"
+#include "palette.hpp"
+#include "snapshot.hpp"
+#include "util.hpp"
+
+namespace fxb
+{
+// Game Boy memory map, plain memory is reached through a table of 256 byte pages so the common case of a read or write
+// is one lookup, pages without a pointer (cartridge control, OAM, I/O) take the slow path. Switching a cartridge, VRAM
+// or WRAM bank rewrites the affected pages so banking costs nothing per access
+class Mmu final : public Bus
+{
+public:
+    static constexpr std::size_t PAGE_SIZE  = 0x100;
+    static constexpr std::size_t PAGE_COUNT = 0x100;
+
+    static constexpr std::uint8_t INTERRUPT_VBLANK = (1u << 0);
+    static constexpr std::uint8_t INTERRUPT_STAT   = (1u << 1);
+    static constexpr std::uint8_t INTERRUPT_TIMER  = (1u << 2);
+    static constexpr std::uint8_t INTERRUPT_SERIAL = (1u << 3);
+    static constexpr std::uint8_t INTERRUPT_JOYPAD = (1u << 4);
+
+    // Bits of the pressed button mask, the lower nibble is read through JOYP bit 5 and the upper one through bit 4
+    static constexpr std::uint8_t BUTTON_A      = (1u << 0);
+    static constexpr std::uint8_t BUTTON_B      = (1u << 1);
+    static constexpr std::uint8_t BUTTON_SELECT = (1u << 2);
+    static constexpr std::uint8_t BUTTON_START  = (1u << 3);
+    static constexpr std::uint8_t BUTTON_RIGHT  = (1u << 4);
+    static constexpr std::uint8_t BUTTON_LEFT   = (1u << 5);
+    static constexpr std::uint8_t BUTTON_UP     = (1u << 6);
+    static constexpr std::uint8_t BUTTON_DOWN   = (1u << 7);
+
+    static constexpr std::size_t VRAM_BANK_SIZE = 0x2000;
+    static constexpr std::size_t WRAM_BANK_SIZE = 0x1000;
+
+    // The CGB boot ROM skips the cartridge header at 0x0100-0x01FF
+    static constexpr std::size_t DMG_BOOT_ROM_SIZE = 0x100;
+    static constexpr std::size_t CGB_BOOT_ROM_SIZE = 0x900;
+
+    // Single speed, the LCD runs at the same pace in double speed mode so a line then takes twice the m-cycles
+    static constexpr std::uint32_t M_CYCLES_PER_LINE = 114;
+    static constexpr std::uint32_t DOTS_PER_LINE     = 456;
+    static constexpr std::uint32_t HBLANK_DOT        = 252;
+    static constexpr std::uint8_t LINES_PER_FRAME    = 154;
+    static constexpr std::uint8_t VBLANK_LINE        = 144;
+
+    using OnSerialCallback = std::function<void(std::uint8_t)>;
+
+private:
+    Cartridge cartridge_;
+    bool cgb_;
+
+    std::vector<std::uint8_t> bootRom_;
+    bool bootRomMapped_;
+
+    // Two VRAM and eight WRAM banks, a DMG only uses the first of each
+    std::array<std::uint8_t, (2 * VRAM_BANK_SIZE)> vram_ = {};
+    std::array<std::uint8_t, (8 * WRAM_BANK_SIZE)> wram_ = {};
+    std::array<std::uint8_t, 0xA0> oam_                  = {};
+    std::array<std::uint8_t, 0x80> io_                   = {};
+    std::array<std::uint8_t, 0x7F> hram_                 = {};
+    std::uint8_t interruptEnable_                        = 0;
+
+    PaletteRam palettes_;
+
+    std::uint8_t vramBank_ = 0;
+    std::uint8_t wramBank_ = 1;
+    bool doubleSpeed_      = false;
+    bool speedSwitchArmed_ = false;
+
+    // hdmaBlocks_ counts the blocks of 16 bytes an HBlank transfer has left
+    std::uint16_t hdmaSource_      = 0;
+    std::uint16_t hdmaDestination_ = 0;
+    std::uint8_t hdmaBlocks_       = 0;
+    bool hdmaActive_               = false;
+    std::uint32_t stallCycles_     = 0;
+
+    std::array<std::uint8_t const*, PAGE_COUNT> readPages_ = {};
+    std::array<std::uint8_t*, PAGE_COUNT> writePages_      = {};
+
+    // Sorted by address, every rom page with a patch reads from its own patched copy of the mapped bank
+    std::vector<RomPatch> romPatches_;
+    std::vector<std::array<std::uint8_t, PAGE_SIZE>> patchedPages_;
+    std::vector<RamPoke> ramPokes_;
+
+    std::uint16_t divider_  = 0;
+    std::uint32_t lineDots_ = 0;
+    std::uint64_t frames_   = 0;
+    std::uint8_t buttons_   = 0;
+
+    OnSerialCallback onSerial = nullptr;
+
+private:
+    void mapPages(std::size_t firstPage, std::size_t count, std::uint8_t const* read, std::uint8_t* write) noexcept;
+    void mapCartridge() noexcept;
+    void mapVram() noexcept;
+    void mapWram() noexcept;
+
+    void patchRomPages() noexcept;
+    void applyRamPokes() noexcept;
+
+    void copyHdmaBlocks(std::size_t blocks) noexcept;
+
+    [[nodiscard]] std::uint8_t readSlow(Address address);
+    void writeSlow(Address address, std::uint8_t value);
+
+    [[nodiscard]] std::uint8_t readIo(std::uint8_t offset) const noexcept;
+    [[nodiscard]] std::uint8_t readJoypad() const noexcept;
+    void writeIo(std::uint8_t offset, std::uint8_t value);
+
+public:
+    // Starts in the power on state with the boot ROM, if any, mapped over the rom. Throws std::invalid_argument when
+    // the boot ROM has neither the DMG nor the CGB size
+    explicit Mmu(Cartridge cartridge, std::vector<std::uint8_t> bootRom = {});
+
+    Mmu(Mmu const&)            = delete;
+    Mmu& operator=(Mmu const&) = delete;
+
+    [[nodiscard]] std::uint8_t read(Address address) override
+    {
+        if (auto const* page = readPages_[getUpper(address.value)])
+        {
+            return page[getLower(address.value)];
+        }
+        return readSlow(address);
+    }
+
+    void write(Address address, std::uint8_t value) override
+    {
+        if (auto* page = writePages_[getUpper(address.value)])
+        {
+            page[getLower(address.value)] = value;
+            return;
+        }
+        writeSlow(address, value);
+    }
+
+    [[nodiscard]] Cartridge const& cartridge() const noexcept { return cartridge_; }
+
+    [[nodiscard]] std::uint8_t interruptFlags() const noexcept { return io_[0x0F]; }
+    [[nodiscard]] std::uint8_t interruptEnable() const noexcept { return interruptEnable_; }
+    void requestInterrupt(std::uint8_t interrupt) noexcept { io_[0x0F] |= interrupt; }
+
+    [[nodiscard]] bool cgb() const noexcept { return cgb_; }
+    // Until the first non-zero write to 0xFF50
+    [[nodiscard]] bool bootRomMapped() const noexcept { return bootRomMapped_; }
+    // Empty when the machine started in the post boot state
+    [[nodiscard]] std::span<std::uint8_t const> bootRom() const noexcept { return bootRom_; }
+    [[nodiscard]] bool doubleSpeed() const noexcept { return doubleSpeed_; }
+
+    // Both banks, the second one stays empty on a DMG
+    [[nodiscard]] std::span<std::uint8_t const, (2 * VRAM_BANK_SIZE)> vram() const noexcept { return vram_; }
+    [[nodiscard]] std::span<std::uint8_t const, 0xA0> oam() const noexcept { return oam_; }
+
+    [[nodiscard]] PaletteRam& palettes() noexcept { return palettes_; }
+    [[nodiscard]] PaletteRam const& palettes() const noexcept { return palettes_; }
+
+    [[nodiscard]] std::uint8_t buttons() const noexcept { return buttons_; }
+    // Replaces the set of pressed buttons, any newly pressed button requests the joypad interrupt
+    void setButtons(std::uint8_t pressed) noexcept;
+
+    // Receives every byte shifted out of the serial port, transfers complete immediately
+    void setOnSerialCallback(OnSerialCallback callback);
+    // Removes the callback and hands it back, for running frames whose output must not reach the host
+    [[nodiscard]] OnSerialCallback takeOnSerialCallback() noexcept { return std::exchange(onSerial, nullptr); }
+
+    // Frames completed since power on, a frame ends when LY wraps back to 0
+    [[nodiscard]] std::uint64_t frames() const noexcept { return frames_; }
+
+    // M-cycles the cpu has to sit out for an HDMA transfer, resets the count
+    [[nodiscard]] std::uint32_t takeStallCycles() noexcept { return std::exchange(stallCycles_, 0); }
+
+    // Cheats are host settings, snapshots leave them alone. Replaces all codes of the respective kind
+    void setRomPatches(std::vector<RomPatch> patches);
+    void setRamPokes(std::vector<RamPoke> pokes);
+    [[nodiscard]] std::span<RomPatch const> romPatches() const noexcept { return romPatches_; }
+    [[nodiscard]] std::span<RamPoke const> ramPokes() const noexcept { return ramPokes_; }
+
+    // Puts the I/O registers into the state the boot ROM of a DMG or CGB leaves them in, for starting at 0x0100
+    // without running one
+    void skipBootRom() noexcept;
+
+    // Switches between single and double speed when armed through KEY1
+    void stop() noexcept override;
+
+    // Advances the divider and the current scanline by one m-cycle
+    void tick() noexcept;
+
+    // Everything but the page tables, which load() rebuilds, and the serial callback
+    void save(SnapshotWriter& writer) const;
+    void load(SnapshotReader& reader);
+};
+} // namespace fxb
+
+#endif // FAUXBOY_MMU_HPP
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef FAUXBOY_PALETTE_HPP
+#define FAUXBOY_PALETTE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <span>
+
+#include "snapshot.hpp"
+
+namespace fxb
+{
+// Host colors are 0xAARRGGBB
+using HostColor = std::uint32_t;
+
+enum class ColorCorrection : std::uint8_t
+{
+    // Every 5 bit channel is widened to 8 bits on its own
+    NONE,
+    // Mixes the channels the way the CGB screen bleeds them into each other, washing out the saturated raw colors
+    LCD
+};
+
+// CGB background and object palette RAM behind BCPS/BCPD and OCPS/OCPD, every write converts the touched color to the
+// host format right away so drawing a pixel is a single load from hostColors()
+class PaletteRam
+{
+public:
+    static constexpr std::size_t PALETTE_COUNT      = 8;
+    static constexpr std::size_t COLORS_PER_PALETTE = 4;
+    static constexpr std::size_t COLORS             = (PALETTE_COUNT * COLORS_PER_PALETTE);
+
+    // Object colors follow the background colors in the host table
+    static constexpr std::size_t OBJECT_COLORS_OFFSET = COLORS;
+    static constexpr std::size_t HOST_COLORS          = (2 * COLORS);
+
+private:
+    // Two little endian bytes per color, background then object palettes
+    std::array<std::uint8_t, (2 * COLORS * 2)> raw_ = {};
+    std::array<HostColor, HOST_COLORS> hostColors_  = {};
+    std::array<std::uint8_t, 2> specs_              = {};
+    ColorCorrection correction_                     = ColorCorrection::NONE;
+
+private:
+    void writeData(std::size_t table, std::uint8_t value) noexcept;
+    void updateHostColor(std::size_t color) noexcept;
+
+public:
+    PaletteRam() noexcept;
+
+    // BCPS and OCPS, bit 7 increments the index after every write to the data register
+    [[nodiscard]] std::uint8_t backgroundSpec() const noexcept { return static_cast<std::uint8_t>(0x40 | specs_[0]); }
+    [[nodiscard]] std::uint8_t objectSpec() const noexcept { return static_cast<std::uint8_t>(0x40 | specs_[1]); }
+    void setBackgroundSpec(std::uint8_t value) noexcept { specs_[0] = (value & 0xBF); }
+    void setObjectSpec(std::uint8_t value) noexcept { specs_[1] = (value & 0xBF); }
+
+    // BCPD and OCPD
+    [[nodiscard]] std::uint8_t backgroundData() const noexcept { return raw_[specs_[0] & 0x3F]; }
+    [[nodiscard]] std::uint8_t objectData() const noexcept { return raw_[(2 * COLORS) + (specs_[1] & 0x3F)]; }
+    void writeBackgroundData(std::uint8_t value) noexcept { writeData(0, value); }
+    void writeObjectData(std::uint8_t value) noexcept { writeData(1, value); }
+
+    [[nodiscard]] ColorCorrection colorCorrection() const noexcept { return correction_; }
+    // Converts the whole table again
+    void setColorCorrection(ColorCorrection correction) noexcept;
+
+    [[nodiscard]] std::span<HostColor const, HOST_COLORS> hostColors() const noexcept { return hostColors_; }
+
+    // The color correction is a host setting and stays as it is
+    void save(SnapshotWriter& writer) const;
+    void load(SnapshotReader& reader);
+};
+
+// Color of a raw 15 bit BGR555 value
+[[nodiscard]] HostColor toHostColor(std::uint16_t bgr555, ColorCorrection correction) noexcept;
+} // namespace fxb
+
+#endif // FAUXBOY_PALETTE_HPP
\ No newline at end of file
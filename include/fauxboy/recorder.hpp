@@ -0,0 +1,103 @@
+#ifndef FAUXBOY_RECORDER_HPP
+#define FAUXBOY_RECORDER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <thread>
+#include <variant>
+
+#include "frame.hpp"
+#include "spsc_queue.hpp"
+
+namespace fxb
+{
+// Records frames as raw Y4M video and audio as 16 bit PCM WAV. The emulation thread only hashes and copies into a
+// preallocated queue slot, conversion and file I/O happen on a background thread. Runs of identical frames cross the
+// queue as a repeat count and the writer repeats the frame it already converted
+class Recorder
+{
+public:
+    static constexpr std::size_t QUEUE_CAPACITY    = 16;
+    static constexpr std::size_t MAX_AUDIO_SAMPLES = 4096;
+
+    struct Options
+    {
+        std::filesystem::path video;
+        // No audio file is written when empty
+        std::filesystem::path audio;
+        // 4194304 / 70224, the DMG refresh rate
+        std::uint32_t frameRateNumerator   = 4'194'304;
+        std::uint32_t frameRateDenominator = 70'224;
+        std::uint32_t sampleRate           = 48'000;
+        std::uint16_t channels             = 2;
+    };
+
+private:
+    struct Frame
+    {
+        HostFramebuffer pixels;
+    };
+
+    struct Repeat
+    {
+        std::uint64_t count = 0;
+    };
+
+    struct Audio
+    {
+        std::array<std::int16_t, MAX_AUDIO_SAMPLES> samples;
+        std::size_t size = 0;
+    };
+
+    struct Stop
+    {
+    };
+
+    using Message = std::variant<Stop, Frame, Repeat, Audio>;
+
+    Options options_;
+    std::ofstream video_;
+    std::ofstream audio_;
+    // Every slot holds a whole frame, well over a megabyte in total, so it lives on the heap and a Recorder fits on any
+    // stack
+    std::unique_ptr<SpscQueue<Message, QUEUE_CAPACITY>> queue_;
+    std::jthread writer_;
+    std::exception_ptr error_;
+
+    std::uint64_t lastHash_       = 0;
+    std::uint64_t pendingRepeats_ = 0;
+    bool hasFrame_                = false;
+    bool closed_                  = false;
+
+private:
+    template <typename Fill>
+    void push(Fill&& fill);
+    void flushRepeats();
+
+    void run() noexcept;
+
+public:
+    // Throws when a file can not be created
+    explicit Recorder(Options options);
+    ~Recorder();
+
+    Recorder(Recorder const&)            = delete;
+    Recorder& operator=(Recorder const&) = delete;
+
+    // Only block when the writer has fallen a whole queue behind
+    void pushFrame(HostFramebuffer const& frame);
+    // Interleaved samples, split into several messages when larger than MAX_AUDIO_SAMPLES
+    void pushAudio(std::span<std::int16_t const> samples);
+
+    // Writes whatever is still queued, finishes both files and rethrows the first error of the writer
+    void close();
+};
+} // namespace fxb
+
+#endif // FAUXBOY_RECORDER_HPP
\ No newline at end of file
@@ -0,0 +1,83 @@
+#ifndef FAUXBOY_RECORDING_BUS_HPP
+#define FAUXBOY_RECORDING_BUS_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <span>
+
+#include "address.hpp"
+#include "flat_bus.hpp"
+
+namespace fxb
+{
+enum class BusActivity : std::uint8_t
+{
+    IDLE,
+    READ,
+    WRITE
+};
+
+struct BusCycle
+{
+    Address address;
+    std::uint8_t data    = 0;
+    BusActivity activity = BusActivity::IDLE;
+
+    [[nodiscard]] constexpr bool operator==(BusCycle const&) const noexcept = default;
+};
+
+// FlatBus that keeps a log of what happened on the bus during each m-cycle, endCycle() has to be called once per cpu
+// tick so cycles without a memory access are logged as IDLE
+class RecordingBus final : public FlatBus
+{
+public:
+    static constexpr std::size_t MAX_CYCLES = 16;
+
+private:
+    std::array<BusCycle, MAX_CYCLES> log_ = {};
+    std::size_t cycleCount_               = 0;
+    BusCycle pending_;
+
+public:
+    [[nodiscard]] std::uint8_t read(Address address) override
+    {
+        auto const value = FlatBus::read(address);
+        pending_         = {.address = address, .data = value, .activity = BusActivity::READ};
+        return value;
+    }
+
+    void write(Address address, std::uint8_t value) override
+    {
+        FlatBus::write(address, value);
+        pending_ = {.address = address, .data = value, .activity = BusActivity::WRITE};
+    }
+
+    void endCycle() noexcept
+    {
+        if (cycleCount_ < MAX_CYCLES)
+        {
+            log_[cycleCount_] = pending_;
+        }
+        ++cycleCount_;
+        pending_ = {};
+    }
+
+    void clearLog() noexcept
+    {
+        cycleCount_ = 0;
+        pending_    = {};
+    }
+
+    // Number of cycles since the last clearLog(), can be larger than the recorded log when it overflowed
+    [[nodiscard]] std::size_t cycleCount() const noexcept { return cycleCount_; }
+
+    [[nodiscard]] std::span<BusCycle const> log() const noexcept
+    {
+        return std::span(log_).first(std::min(cycleCount_, MAX_CYCLES));
+    }
+};
+} // namespace fxb
+
+#endif // FAUXBOY_RECORDING_BUS_HPP
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef FAUXBOY_RUN_AHEAD_HPP
+#define FAUXBOY_RUN_AHEAD_HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "game_boy.hpp"
+
+namespace fxb
+{
+// Hides the input lag games build in by showing the machine a few frames into the future, as it would look if the
+// buttons held now stay held. Every call runs the real frame, then the frames ahead on a throwaway copy of the state
+//
+//     RunAhead runAhead(gameBoy, 2);
+//     runAhead.runFrame(buttons, [](GameBoy const& ahead) { draw(ahead); });
+class RunAhead
+{
+public:
+    enum class Mode
+    {
+        // Saves the machine, runs it ahead and restores it, serial output of the frames ahead is held back
+        Restore,
+        // Restores the snapshot into a second instance and runs that ahead, so the machine itself never rewinds and
+        // its callbacks only ever see real frames. Costs the same save and restore per frame plus the memory
+        SecondInstance,
+    };
+
+    // Sees the machine that is frames() ahead of the real one, only valid during the call
+    using Present = std::function<void(GameBoy const& ahead)>;
+
+private:
+    GameBoy* gameBoy_;
+    std::uint32_t frames_;
+    Mode mode_;
+    std::unique_ptr<GameBoy> shadow_;
+    // Reused every frame so saving does not allocate once it reached the size of a snapshot
+    std::vector<std::uint8_t> snapshot_;
+
+    void runAhead(GameBoy& gameBoy);
+
+public:
+    // Zero frames presents the real machine after every frame. The machine has to outlive the helper
+    RunAhead(GameBoy& gameBoy, std::uint32_t frames, Mode mode = Mode::Restore);
+
+    RunAhead(RunAhead const&)            = delete;
+    RunAhead& operator=(RunAhead const&) = delete;
+
+    [[nodiscard]] std::uint32_t frames() const noexcept { return frames_; }
+    [[nodiscard]] Mode mode() const noexcept { return mode_; }
+
+    // Runs one real frame with the buttons held, then frames() more on the copy with the same buttons and presents it
+    void runFrame(std::uint8_t buttons, Present const& present);
+};
+} // namespace fxb
+
+#endif // FAUXBOY_RUN_AHEAD_HPP
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef FAUXBOY_SCALE_HPP
+#define FAUXBOY_SCALE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+
+#include "frame.hpp"
+#include "palette.hpp"
+
+namespace fxb
+{
+// Output filters reading the indexed framebuffer and writing host colors into caller owned buffers. Every filter works
+// a row at a time over fixed width arrays without branches in the inner loops, so the compiler turns the copies, the
+// Scale2x edge selection and the channel sums into vector code. Looking colors up by palette index stays scalar on
+// targets without gather instructions. The functions throw std::invalid_argument when the output does not have the
+// documented size
+
+// Region of the screen in pixels, its size has to be a multiple of the downsampling factor
+struct Crop
+{
+    std::size_t x      = 0;
+    std::size_t y      = 0;
+    std::size_t width  = SCREEN_WIDTH;
+    std::size_t height = SCREEN_HEIGHT;
+};
+
+// Repeats every pixel factor times in both directions, the output holds SCREEN_PIXELS * factor * factor colors
+void upscaleNearest(IndexedFramebuffer const& frame,
+                    std::span<HostColor const, PaletteRam::HOST_COLORS> colors,
+                    std::size_t factor,
+                    std::span<HostColor> output);
+
+// Scale2x, which rounds off diagonal staircases without blurring. Edges are found by comparing palette indices so two
+// indices of the same color count as an edge. The output holds 4 * SCREEN_PIXELS colors
+void smooth2x(IndexedFramebuffer const& frame,
+              std::span<HostColor const, PaletteRam::HOST_COLORS> colors,
+              std::span<HostColor> output);
+
+// Averages every block of factor x factor pixels of the crop per channel, factor is 2 or 4. The output holds
+// (crop.width / factor) * (crop.height / factor) colors
+void downsample(IndexedFramebuffer const& frame,
+                std::span<HostColor const, PaletteRam::HOST_COLORS> colors,
+                std::size_t factor,
+                std::span<HostColor> output,
+                Crop const& crop = {});
+} // namespace fxb
+
+#endif // FAUXBOY_SCALE_HPP
\ No newline at end of file
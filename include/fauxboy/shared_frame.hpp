@@ -0,0 +1,114 @@
+#ifndef FAUXBOY_SHARED_FRAME_HPP
+#define FAUXBOY_SHARED_FRAME_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <atomic>
+#include <string>
+#include <utility>
+
+#include "frame.hpp"
+
+namespace fxb
+{
+// The layout of the shared memory object, viewers in other languages mirror it. Each buffer has its own sequence
+// which is odd while the writer fills it. The writer never touches the latest buffer, so a viewer that starts reading
+// it has two whole frames before its contents get overwritten and the sequence check fails
+struct SharedFrameLayout
+{
+    static constexpr std::uint32_t MAGIC   = 0x46584246;
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::size_t BUFFERS   = 3;
+    static constexpr std::size_t ALIGNMENT = 64;
+
+    std::uint32_t magic   = MAGIC;
+    std::uint32_t version = VERSION;
+    std::uint32_t width   = SCREEN_WIDTH;
+    std::uint32_t height  = SCREEN_HEIGHT;
+
+    // Bumped once per published frame, viewers poll it to notice new frames
+    alignas(ALIGNMENT) std::atomic<std::uint64_t> generation = 0;
+    std::atomic<std::uint32_t> latest                        = 0;
+
+    alignas(ALIGNMENT) std::array<std::atomic<std::uint64_t>, BUFFERS> sequences = {};
+    alignas(ALIGNMENT) std::array<HostFramebuffer, BUFFERS> buffers              = {};
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Shared atomics must not need a lock");
+
+// Publishes frames into a POSIX shared memory object named like "/fauxboy-1". Publishing is a few stores into the
+// mapping, the emulator never copies a frame nor makes a syscall after construction
+class SharedFrameWriter
+{
+private:
+    std::string name_;
+    SharedFrameLayout* layout_ = nullptr;
+    std::uint32_t back_        = 1;
+
+public:
+    // Replaces a stale object of the same name, throws std::system_error when it can not be created
+    explicit SharedFrameWriter(std::string name);
+    ~SharedFrameWriter();
+
+    SharedFrameWriter(SharedFrameWriter const&)            = delete;
+    SharedFrameWriter& operator=(SharedFrameWriter const&) = delete;
+
+    // Returns the buffer to draw the next frame into, viewers only see it after publish()
+    [[nodiscard]] HostFramebuffer& beginFrame() noexcept;
+    void publish() noexcept;
+
+    // For producers that can not draw into the mapping directly
+    void publish(HostFramebuffer const& frame) noexcept;
+};
+
+// Maps a writer's object read-only
+class SharedFrameReader
+{
+private:
+    SharedFrameLayout const* layout_ = nullptr;
+
+public:
+    // Throws std::system_error when there is no such object, std::runtime_error when it is not a frame buffer
+    explicit SharedFrameReader(std::string const& name);
+    ~SharedFrameReader();
+
+    SharedFrameReader(SharedFrameReader const&)            = delete;
+    SharedFrameReader& operator=(SharedFrameReader const&) = delete;
+
+    [[nodiscard]] std::uint64_t generation() const noexcept
+    {
+        return layout_->generation.load(std::memory_order_acquire);
+    }
+
+    // Hands the newest frame to visit() straight from the mapping. Returns false when the writer reused the buffer in
+    // the meantime, whatever visit() derived from it has to be dropped then
+    template <typename Visit>
+    bool tryRead(Visit&& visit) const
+    {
+        auto const index    = layout_->latest.load(std::memory_order_acquire);
+        auto const& current = layout_->sequences[index];
+
+        auto const before = current.load(std::memory_order_acquire);
+        if ((before & 1) != 0)
+        {
+            return false;
+        }
+
+        std::forward<Visit>(visit)(layout_->buffers[index]);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return (current.load(std::memory_order_relaxed) == before);
+    }
+
+    // Copies the newest frame, retrying until it gets a consistent one
+    void read(HostFramebuffer& output) const noexcept
+    {
+        while (!tryRead([&output](HostFramebuffer const& frame) { output = frame; }))
+        {
+        }
+    }
+};
+} // namespace fxb
+
+#endif // FAUXBOY_SHARED_FRAME_HPP
\ No newline at end of file
@@ -0,0 +1,100 @@
+#ifndef FAUXBOY_SNAPSHOT_HPP
+#define FAUXBOY_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "hash.hpp"
+
+namespace fxb
+{
+class BadSnapshotException : public std::runtime_error
+{
+public:
+    explicit BadSnapshotException(std::string const& reason)
+        : std::runtime_error(reason)
+    {
+    }
+};
+
+// Machine state as a flat byte string in native byte order, every component writes its fields and reads them back in
+// the same order. A snapshot only fits the rom it was taken from
+class SnapshotWriter
+{
+private:
+    std::vector<std::uint8_t>* bytes_ = nullptr;
+    HashStream* hash_                 = nullptr;
+
+public:
+    // Appends to the bytes, a cleared vector keeps its capacity so a reused buffer does not allocate again
+    explicit SnapshotWriter(std::vector<std::uint8_t>& bytes) noexcept
+        : bytes_(&bytes)
+    {
+    }
+
+    // Hashes the state in place of storing it, the result matches hashBytes() over the snapshot
+    explicit SnapshotWriter(HashStream& hash) noexcept
+        : hash_(&hash)
+    {
+    }
+
+    void write(std::span<std::uint8_t const> bytes)
+    {
+        if (bytes_ != nullptr)
+        {
+            bytes_->insert(bytes_->end(), bytes.begin(), bytes.end());
+        }
+        else
+        {
+            hash_->update(bytes);
+        }
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void write(T const& value)
+    {
+        write(std::span(reinterpret_cast<std::uint8_t const*>(&value), sizeof(T)));
+    }
+};
+
+class SnapshotReader
+{
+private:
+    std::span<std::uint8_t const> bytes_;
+
+public:
+    explicit SnapshotReader(std::span<std::uint8_t const> bytes) noexcept
+        : bytes_(bytes)
+    {
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return bytes_.empty(); }
+
+    // Throws BadSnapshotException when the snapshot ends early
+    void read(std::span<std::uint8_t> bytes)
+    {
+        if (bytes_.size() < bytes.size())
+        {
+            throw BadSnapshotException("Truncated snapshot");
+        }
+        std::ranges::copy(bytes_.first(bytes.size()), bytes.begin());
+        bytes_ = bytes_.subspan(bytes.size());
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void read(T& value)
+    {
+        read(std::span(reinterpret_cast<std::uint8_t*>(&value), sizeof(T)));
+    }
+};
+} // namespace fxb
+
+#endif // FAUXBOY_SNAPSHOT_HPP
\ No newline at end of file
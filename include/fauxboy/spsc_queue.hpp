@@ -0,0 +1,82 @@
+#ifndef FAUXBOY_SPSC_QUEUE_HPP
+#define FAUXBOY_SPSC_QUEUE_HPP
+
+#include <cstddef>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <utility>
+
+namespace fxb
+{
+// Bounded single producer single consumer ring buffer, neither side ever takes a lock. Slots are constructed up front
+// and reused, so pushing copies into an existing slot instead of allocating. Each index lives on its own cache line
+// so the two threads only share the slot they hand over
+template <std::default_initializable T, std::size_t Capacity>
+    requires(std::has_single_bit(Capacity))
+class SpscQueue
+{
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    std::array<T, Capacity> slots_ = {};
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> head_ = 0;
+    alignas(CACHE_LINE) std::atomic<std::size_t> tail_ = 0;
+
+public:
+    // Producer side, fill() receives the slot to write into and is only called when there is room
+    template <typename Fill>
+    [[nodiscard]] bool tryPush(Fill&& fill)
+    {
+        auto const tail = tail_.load(std::memory_order_relaxed);
+        if ((tail - head_.load(std::memory_order_acquire)) == Capacity)
+        {
+            return false;
+        }
+
+        std::forward<Fill>(fill)(slots_[tail % Capacity]);
+        tail_.store((tail + 1), std::memory_order_release);
+        tail_.notify_one();
+        return true;
+    }
+
+    // Consumer side, consume() receives the oldest slot which stays owned by the consumer until it returns
+    template <typename Consume>
+    [[nodiscard]] bool tryPop(Consume&& consume)
+    {
+        auto const head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        std::forward<Consume>(consume)(slots_[head % Capacity]);
+        head_.store((head + 1), std::memory_order_release);
+        head_.notify_one();
+        return true;
+    }
+
+    // Consumer side, sleeps while the queue is empty
+    void waitForItems() const noexcept
+    {
+        auto const head = head_.load(std::memory_order_relaxed);
+        tail_.wait(head, std::memory_order_acquire);
+    }
+
+    // Producer side, sleeps while the queue is full
+    void waitForRoom() const noexcept
+    {
+        auto const tail = tail_.load(std::memory_order_relaxed);
+        head_.wait((tail - Capacity), std::memory_order_acquire);
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return (head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire));
+    }
+};
+} // namespace fxb
+
+#endif // FAUXBOY_SPSC_QUEUE_HPP
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef FAUXBOY_TERMINAL_RENDERER_HPP
+#define FAUXBOY_TERMINAL_RENDERER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <chrono>
+#include <string>
+
+#include "frame.hpp"
+#include "palette.hpp"
+
+namespace fxb
+{
+// Draws frames on a 256 color terminal, each character cell is an upper half block whose foreground is the upper
+// pixel and whose background the lower one. Only cells that changed since the last drawn frame are sent, so a mostly
+// static screen costs a few bytes per frame
+class TerminalRenderer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t COLUMNS = SCREEN_WIDTH;
+    static constexpr std::size_t ROWS    = (SCREEN_HEIGHT / 2);
+
+private:
+    // Foreground in bits 8-15, background in bits 0-7, wider than a cell so a value past 0xFFFF can mark it unknown
+    std::array<std::uint32_t, (COLUMNS * ROWS)> cells_ = {};
+    bool drawn_                                        = false;
+
+    Clock::duration interval_;
+    Clock::time_point lastDraw_ = {};
+
+public:
+    // 15 frames per second keep the stream readable over a slow ssh link
+    explicit TerminalRenderer(Clock::duration interval = std::chrono::milliseconds(66)) noexcept
+        : interval_(interval)
+    {
+    }
+
+    // Appends the escape sequences bringing the terminal from the last drawn frame to this one. Returns false and
+    // appends nothing when the previous frame was drawn less than the interval ago
+    bool render(HostFramebuffer const& frame, std::string& output, Clock::time_point now = Clock::now());
+
+    // Redraws every cell next time, after the terminal was cleared or resized
+    void invalidate() noexcept { drawn_ = false; }
+};
+
+// Nearest entry of the xterm 256 color palette, either the 6x6x6 cube or the gray ramp
+[[nodiscard]] std::uint8_t toXterm256(HostColor color) noexcept;
+} // namespace fxb
+
+#endif // FAUXBOY_TERMINAL_RENDERER_HPP
\ No newline at end of file
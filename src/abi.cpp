@@ -0,0 +1,192 @@
+#include "abi.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <new>
+#include <span>
+#include <vector>
+
+#include "cartridge.hpp"
+#include "cpu.hpp"
+#include "game_boy.hpp"
+#include "recording_bus.hpp"
+
+struct fxb_machine
+{
+    fxb::RecordingBus bus;
+    fxb::Cpu cpu         = fxb::Cpu(&bus);
+    std::uint64_t cycles = 0;
+};
+
+struct fxb_game_boy
+{
+    fxb::GameBoy gameBoy;
+    // Reused by every fxb_game_boy_save so the size query and the copy that follows see the same snapshot
+    mutable std::vector<std::uint8_t> snapshot;
+};
+
+namespace
+{
+// Exceptions must not cross the C boundary
+template <typename Step>
+fxb_status guarded(Step&& step) noexcept
+{
+    try
+    {
+        step();
+    }
+    catch (fxb::IllegalOpcodeException const&)
+    {
+        return FXB_ILLEGAL_OPCODE;
+    }
+    catch (...)
+    {
+        return FXB_ERROR;
+    }
+    return FXB_OK;
+}
+} // namespace
+
+std::uint32_t fxb_abi_version() noexcept
+{
+    return FXB_ABI_VERSION;
+}
+
+fxb_machine* fxb_create() noexcept
+{
+    auto* machine = new (std::nothrow) fxb_machine();
+    if (machine != nullptr)
+    {
+        machine->cpu.setOnTickCallback(
+            [machine](fxb::Cpu*)
+            {
+                machine->bus.endCycle();
+                ++machine->cycles;
+            });
+    }
+    return machine;
+}
+
+void fxb_destroy(fxb_machine* machine) noexcept
+{
+    delete machine;
+}
+
+void fxb_load(fxb_machine* machine, fxb::CpuState const* state, std::uint8_t const* memory) noexcept
+{
+    std::copy_n(memory, FXB_MEMORY_SIZE, machine->bus.memory().begin());
+    machine->cpu.reset(*state);
+    machine->bus.clearLog();
+    machine->cycles = 0;
+}
+
+void fxb_save(fxb_machine const* machine, fxb::CpuState* state, std::uint8_t* memory) noexcept
+{
+    std::ranges::copy(machine->bus.memory(), memory);
+    *state = machine->cpu.state();
+}
+
+fxb_status fxb_step(fxb_machine* machine, std::uint64_t count, std::uint64_t* executed) noexcept
+{
+    *executed = 0;
+    return guarded(
+        [&]
+        {
+            for (; *executed < count; ++*executed)
+            {
+                machine->bus.clearLog();
+                machine->cpu.step();
+            }
+        });
+}
+
+std::uint64_t fxb_cycles(fxb_machine const* machine) noexcept
+{
+    return machine->cycles;
+}
+
+std::size_t fxb_bus_log(fxb_machine const* machine, fxb::BusCycle* log, std::size_t capacity) noexcept
+{
+    auto const recorded = machine->bus.log();
+    std::copy_n(recorded.begin(), std::min(recorded.size(), capacity), log);
+    return machine->bus.cycleCount();
+}
+
+fxb_game_boy* fxb_game_boy_create(std::uint8_t const* rom, std::size_t size) noexcept
+{
+    try
+    {
+        return new fxb_game_boy{.gameBoy = fxb::GameBoy(fxb::Cartridge(std::vector(rom, (rom + size))))};
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void fxb_game_boy_destroy(fxb_game_boy* gameBoy) noexcept
+{
+    delete gameBoy;
+}
+
+void fxb_game_boy_set_buttons(fxb_game_boy* gameBoy, std::uint8_t pressed) noexcept
+{
+    gameBoy->gameBoy.mmu().setButtons(pressed);
+}
+
+fxb_status fxb_game_boy_run_frame(fxb_game_boy* gameBoy) noexcept
+{
+    return guarded([&] { gameBoy->gameBoy.runFrame(); });
+}
+
+fxb_status fxb_game_boy_step(fxb_game_boy* gameBoy, std::uint64_t count, std::uint64_t* executed) noexcept
+{
+    *executed = 0;
+    return guarded(
+        [&]
+        {
+            for (; *executed < count; ++*executed)
+            {
+                gameBoy->gameBoy.step();
+            }
+        });
+}
+
+std::uint64_t fxb_game_boy_hash(fxb_game_boy const* gameBoy) noexcept
+{
+    return gameBoy->gameBoy.hash();
+}
+
+std::uint64_t fxb_game_boy_cycles(fxb_game_boy const* gameBoy) noexcept
+{
+    return gameBoy->gameBoy.cycles();
+}
+
+void fxb_game_boy_cpu_state(fxb_game_boy const* gameBoy, fxb::CpuState* state) noexcept
+{
+    *state = gameBoy->gameBoy.cpu().state();
+}
+
+std::size_t fxb_game_boy_save(fxb_game_boy const* gameBoy, std::uint8_t* buffer, std::size_t capacity) noexcept
+{
+    try
+    {
+        gameBoy->gameBoy.save(gameBoy->snapshot);
+    }
+    catch (...)
+    {
+        return 0;
+    }
+
+    if (gameBoy->snapshot.size() <= capacity)
+    {
+        std::ranges::copy(gameBoy->snapshot, buffer);
+    }
+    return gameBoy->snapshot.size();
+}
+
+fxb_status fxb_game_boy_load(fxb_game_boy* gameBoy, std::uint8_t const* snapshot, std::size_t size) noexcept
+{
+    return guarded([&] { gameBoy->gameBoy.load(std::span(snapshot, size)); });
+}
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "cartridge.hpp"
+
+#include <cstdint>
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include "address.hpp"
+
+namespace fxb
+{
+namespace
+{
+constexpr std::size_t TITLE_OFFSET          = 0x0134;
+constexpr std::size_t MAX_TITLE_LENGTH      = 16;
+constexpr std::size_t CGB_FLAG_OFFSET       = 0x0143;
+constexpr std::size_t CARTRIDGE_TYPE_OFFSET = 0x0147;
+constexpr std::size_t RAM_SIZE_OFFSET       = 0x0149;
+constexpr std::size_t HEADER_END            = 0x0150;
+
+MemoryBankController controllerFromType(std::uint8_t type)
+{
+    switch (type)
+    {
+        case 0x00:
+        case 0x08:
+        case 0x09: return MemoryBankController::NONE;
+        case 0x01:
+        case 0x02:
+        case 0x03: return MemoryBankController::MBC1;
+        case 0x19:
+        case 0x1A:
+        case 0x1B:
+        case 0x1C:
+        case 0x1D:
+        case 0x1E: return MemoryBankController::MBC5;
+        default: throw BadCartridgeException(std::format("Unsupported cartridge type: 0x{:02X}", type));
+    }
+}
+
+std::size_t ramSizeFromCode(std::uint8_t code)
+{
+    switch (code)
+    {
+        case 0x00: return 0;
+        // 2KiB parts are rounded up to a whole bank
+        case 0x01:
+        case 0x02: return Cartridge::RAM_BANK_SIZE;
+        case 0x03: return (4 * Cartridge::RAM_BANK_SIZE);
+        case 0x04: return (16 * Cartridge::RAM_BANK_SIZE);
+        case 0x05: return (8 * Cartridge::RAM_BANK_SIZE);
+        default: throw BadCartridgeException(std::format("Unsupported ram size: 0x{:02X}", code));
+    }
+}
+} // namespace
+
+Cartridge::Cartridge(std::vector<std::uint8_t> rom)
+    : rom_(std::make_shared<std::vector<std::uint8_t> const>(std::move(rom)))
+{
+    if ((rom_->size() < (2 * ROM_BANK_SIZE)) || ((rom_->size() % ROM_BANK_SIZE) != 0))
+    {
+        throw BadCartridgeException(std::format("Rom size is not a multiple of 16KiB: {} bytes", rom_->size()));
+    }
+    static_assert(HEADER_END < ROM_BANK_SIZE);
+
+    controller_  = controllerFromType((*rom_)[CARTRIDGE_TYPE_OFFSET]);
+    supportsCgb_ = (((*rom_)[CGB_FLAG_OFFSET] & 0x80) != 0);
+    ram_.resize(ramSizeFromCode((*rom_)[RAM_SIZE_OFFSET]), 0x00);
+
+    // Cartridges without a controller have their ram, if any, always mapped
+    ramEnabled_ = (controller_ == MemoryBankController::NONE);
+
+    // The last byte of the title doubles as the CGB flag
+    auto const titleLength = (supportsCgb_ ? (MAX_TITLE_LENGTH - 1) : MAX_TITLE_LENGTH);
+    auto const title       = std::span(*rom_).subspan(TITLE_OFFSET, titleLength);
+    std::ranges::copy(title.begin(), std::ranges::find(title, 0x00), std::back_inserter(title_));
+}
+
+Cartridge Cartridge::load(std::filesystem::path const& path)
+{
+    auto ifs = std::ifstream(path, std::ios::binary);
+    if (!ifs.is_open())
+    {
+        throw BadCartridgeException(std::format("Could not open file: {}", path.c_str()));
+    }
+    return Cartridge(std::vector<std::uint8_t>(std::istreambuf_iterator(ifs), {}));
+}
+
+std::size_t Cartridge::lowerRomBankIndex() const noexcept
+{
+    if ((controller_ == MemoryBankController::MBC1) && advancedBankingMode_)
+    {
+        return ((romBankHigh_ << 5) % romBankCount());
+    }
+    return 0;
+}
+
+std::size_t Cartridge::upperRomBankIndex() const noexcept
+{
+    switch (controller_)
+    {
+        case MemoryBankController::NONE: return 1;
+        case MemoryBankController::MBC1: return (((romBankHigh_ << 5) | romBankLow_) % romBankCount());
+        case MemoryBankController::MBC5: return (romBankLow_ % romBankCount());
+    }
+    std::unreachable();
+}
+
+std::size_t Cartridge::ramBankIndex() const noexcept
+{
+    switch (controller_)
+    {
+        case MemoryBankController::NONE: return 0;
+        case MemoryBankController::MBC1: return ((advancedBankingMode_ ? romBankHigh_ : 0) % ramBankCount());
+        case MemoryBankController::MBC5: return (ramBank_ % ramBankCount());
+    }
+    std::unreachable();
+}
+
+std::span<std::uint8_t const, Cartridge::ROM_BANK_SIZE> Cartridge::lowerRomBank() const noexcept
+{
+    return std::span(*rom_).subspan(lowerRomBankIndex() * ROM_BANK_SIZE).first<ROM_BANK_SIZE>();
+}
+
+std::span<std::uint8_t const, Cartridge::ROM_BANK_SIZE> Cartridge::upperRomBank() const noexcept
+{
+    return std::span(*rom_).subspan(upperRomBankIndex() * ROM_BANK_SIZE).first<ROM_BANK_SIZE>();
+}
+
+std::span<std::uint8_t> Cartridge::ramBank() noexcept
+{
+    if (!ramEnabled_ || ram_.empty())
+    {
+        return {};
+    }
+    return std::span(ram_).subspan(ramBankIndex() * RAM_BANK_SIZE, RAM_BANK_SIZE);
+}
+
+void Cartridge::writeControl(Address address, std::uint8_t value) noexcept
+{
+    switch (controller_)
+    {
+        case MemoryBankController::NONE: break;
+        case MemoryBankController::MBC1:
+        {
+            if (address < 0x2000)
+            {
+                ramEnabled_ = ((value & 0x0F) == 0x0A);
+            }
+            else if (address < 0x4000)
+            {
+                romBankLow_ = std::max<std::uint16_t>((value & 0x1F), 1);
+            }
+            else if (address < 0x6000)
+            {
+                romBankHigh_ = (value & 0x03);
+            }
+            else
+            {
+                advancedBankingMode_ = ((value & 0x01) != 0);
+            }
+            break;
+        }
+        case MemoryBankController::MBC5:
+        {
+            if (address < 0x2000)
+            {
+                ramEnabled_ = (value == 0x0A);
+            }
+            else if (address < 0x3000)
+            {
+                romBankLow_ = ((romBankLow_ & 0x100) | value);
+            }
+            else if (address < 0x4000)
+            {
+                romBankLow_ = ((romBankLow_ & 0xFF) | ((value & 0x01) << 8));
+            }
+            else if (address < 0x6000)
+            {
+                ramBank_ = (value & 0x0F);
+            }
+            break;
+        }
+    }
+}
+
+void Cartridge::save(SnapshotWriter& writer) const
+{
+    writer.write(ram_);
+    writer.write(romBankLow_);
+    writer.write(romBankHigh_);
+    writer.write(ramBank_);
+    writer.write(ramEnabled_);
+    writer.write(advancedBankingMode_);
+}
+
+void Cartridge::load(SnapshotReader& reader)
+{
+    reader.read(ram_);
+    reader.read(romBankLow_);
+    reader.read(romBankHigh_);
+    reader.read(ramBank_);
+    reader.read(ramEnabled_);
+    reader.read(advancedBankingMode_);
+}
+} // namespace fxb
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "cheats.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <format>
+#include <stdexcept>
+#include <vector>
+
+namespace fxb
+{
+namespace
+{
+std::vector<std::uint8_t> parseDigits(std::string_view code)
+{
+    std::vector<std::uint8_t> digits;
+    for (auto const c : code)
+    {
+        if ((c >= '0') && (c <= '9'))
+        {
+            digits.push_back(static_cast<std::uint8_t>(c - '0'));
+        }
+        else if ((c >= 'A') && (c <= 'F'))
+        {
+            digits.push_back(static_cast<std::uint8_t>(c - 'A' + 10));
+        }
+        else if ((c >= 'a') && (c <= 'f'))
+        {
+            digits.push_back(static_cast<std::uint8_t>(c - 'a' + 10));
+        }
+        else if (c != '-')
+        {
+            throw std::invalid_argument(std::format("Invalid character in cheat code {}", code));
+        }
+    }
+    return digits;
+}
+} // namespace
+
+// The address is stored scrambled as digits F, C, D and E with F inverted, the compare byte as G and I rotated and
+// XORed. H only serves as a checksum on the original hardware
+RomPatch parseGameGenie(std::string_view code)
+{
+    auto const digits = parseDigits(code);
+    if ((digits.size() != 6) && (digits.size() != 9))
+    {
+        throw std::invalid_argument(std::format("Game Genie code {} needs 6 or 9 digits", code));
+    }
+
+    RomPatch patch;
+    patch.value   = static_cast<std::uint8_t>((digits[0] << 4) | digits[1]);
+    patch.address = static_cast<std::uint16_t>(((digits[5] ^ 0x0F) << 12) | (digits[2] << 8) | (digits[3] << 4) |
+                                               digits[4]);
+    if (patch.address >= 0x8000)
+    {
+        throw std::invalid_argument(
+            std::format("Game Genie code {} patches {:#06x} outside the rom", code, patch.address));
+    }
+
+    if (digits.size() == 9)
+    {
+        auto const scrambled = static_cast<std::uint8_t>((digits[6] << 4) | digits[8]);
+        patch.compare        = static_cast<std::uint8_t>(((scrambled >> 2) | (scrambled << 6)) ^ 0xBA);
+    }
+    return patch;
+}
+
+RamPoke parseGameShark(std::string_view code)
+{
+    auto const digits = parseDigits(code);
+    if (digits.size() != 8)
+    {
+        throw std::invalid_argument(std::format("GameShark code {} needs 8 digits", code));
+    }
+
+    auto const byte = [&digits](std::size_t i)
+    {
+        return static_cast<std::uint8_t>((digits[2 * i] << 4) | digits[(2 * i) + 1]);
+    };
+
+    RamPoke poke;
+    poke.value   = byte(1);
+    poke.address = static_cast<std::uint16_t>(byte(2) | (byte(3) << 8));
+
+    auto const type = byte(0);
+    if ((type & 0xF8) == 0x90)
+    {
+        poke.wramBank = static_cast<std::uint8_t>(type & 0x07);
+    }
+    else if (type != 0x01)
+    {
+        throw std::invalid_argument(std::format("GameShark code {} has the unsupported type {:02X}", code, type));
+    }
+
+    bool const cartridgeRamOrWram = ((poke.address >= 0xA000) && (poke.address < 0xE000));
+    bool const hram               = ((poke.address >= 0xFF80) && (poke.address < 0xFFFF));
+    if (!cartridgeRamOrWram && !hram)
+    {
+        throw std::invalid_argument(std::format("GameShark code {} writes {:#06x} outside of RAM", code, poke.address));
+    }
+    if (poke.wramBank && ((poke.address < 0xD000) || (poke.address >= 0xE000)))
+    {
+        throw std::invalid_argument(std::format("GameShark code {} pins a WRAM bank outside 0xD000-0xDFFF", code));
+    }
+    return poke;
+}
+} // namespace fxb
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "control.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <concepts>
+#include <exception>
+#include <format>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "address.hpp"
+#include "cartridge.hpp"
+
+namespace fxb
+{
+namespace
+{
+template <std::unsigned_integral T>
+T readLittleEndian(std::span<std::uint8_t const> bytes) noexcept
+{
+    T value = 0;
+    std::memcpy(&value, bytes.data(), sizeof(T));
+    if constexpr (std::endian::native == std::endian::big)
+    {
+        value = std::byteswap(value);
+    }
+    return value;
+}
+
+template <std::unsigned_integral T>
+void appendLittleEndian(std::vector<std::uint8_t>& bytes, T value)
+{
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+    {
+        bytes.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+    }
+}
+
+void expectPayloadSize(std::span<std::uint8_t const> payload, std::size_t size)
+{
+    if (payload.size() != size)
+    {
+        throw std::invalid_argument(std::format("Expected a payload of {} bytes, got {}", size, payload.size()));
+    }
+}
+
+void appendReply(std::vector<std::uint8_t>& replies, ControlStatus status, std::span<std::uint8_t const> data)
+{
+    replies.push_back(static_cast<std::uint8_t>(status));
+    appendLittleEndian(replies, static_cast<std::uint32_t>(data.size()));
+    replies.insert(replies.end(), data.begin(), data.end());
+}
+
+void appendError(std::vector<std::uint8_t>& replies, ControlStatus status, std::string_view message)
+{
+    appendReply(replies, status, std::span(reinterpret_cast<std::uint8_t const*>(message.data()), message.size()));
+}
+} // namespace
+
+GameBoy& ControlSession::gameBoy()
+{
+    if (!gameBoy_)
+    {
+        throw std::logic_error("No rom loaded");
+    }
+    return *gameBoy_;
+}
+
+ControlStatus ControlSession::execute(ControlCommand command,
+                                      std::span<std::uint8_t const> payload,
+                                      std::vector<std::uint8_t>& data)
+{
+    switch (command)
+    {
+        case ControlCommand::LOAD:
+        {
+            gameBoy_ = std::make_unique<GameBoy>(Cartridge(std::vector(payload.begin(), payload.end())));
+            return ControlStatus::OK;
+        }
+        case ControlCommand::STEP_FRAMES:
+        {
+            expectPayloadSize(payload, sizeof(std::uint32_t));
+            auto& machine = gameBoy();
+            for (auto frames = readLittleEndian<std::uint32_t>(payload); frames > 0; --frames)
+            {
+                machine.runFrame();
+            }
+            appendLittleEndian(data, machine.cycles());
+            return ControlStatus::OK;
+        }
+        case ControlCommand::SET_BUTTONS:
+        {
+            expectPayloadSize(payload, sizeof(std::uint8_t));
+            gameBoy().mmu().setButtons(payload[0]);
+            return ControlStatus::OK;
+        }
+        case ControlCommand::READ_MEMORY:
+        {
+            expectPayloadSize(payload, (sizeof(std::uint16_t) + sizeof(std::uint32_t)));
+            auto const address = readLittleEndian<std::uint16_t>(payload);
+            auto const length  = readLittleEndian<std::uint32_t>(payload.subspan(sizeof(std::uint16_t)));
+            if ((address + std::uint64_t{length}) > 0x10000)
+            {
+                throw std::out_of_range(std::format("Range {:#06x}+{:#x} wraps around", address, length));
+            }
+
+            auto& mmu = gameBoy().mmu();
+            data.reserve(length);
+            for (std::uint32_t i = 0; i < length; ++i)
+            {
+                data.push_back(mmu.read(Address(static_cast<std::uint16_t>(address + i))));
+            }
+            return ControlStatus::OK;
+        }
+        case ControlCommand::SAVE_STATE:
+        {
+            expectPayloadSize(payload, 0);
+            data = gameBoy().save();
+            return ControlStatus::OK;
+        }
+        case ControlCommand::LOAD_STATE:
+        {
+            gameBoy().load(payload);
+            return ControlStatus::OK;
+        }
+        case ControlCommand::GET_FRAMEBUFFER:
+        {
+            // The LCD does not draw pixels yet, the command is reserved so clients can probe for it
+            constexpr std::string_view MESSAGE = "The LCD does not produce frames yet";
+            data.assign(MESSAGE.begin(), MESSAGE.end());
+            return ControlStatus::UNSUPPORTED;
+        }
+    }
+
+    throw std::invalid_argument(std::format("Unknown command {}", static_cast<unsigned>(command)));
+}
+
+void ControlSession::handle(std::span<std::uint8_t const> batch, std::vector<std::uint8_t>& replies)
+{
+    std::vector<std::uint8_t> data;
+    while (!batch.empty())
+    {
+        if (batch.size() < COMMAND_HEADER_SIZE)
+        {
+            appendError(replies, ControlStatus::ERROR, "Truncated command header");
+            return;
+        }
+
+        auto const command = static_cast<ControlCommand>(batch[0]);
+        auto const length  = readLittleEndian<std::uint32_t>(batch.subspan(1));
+        batch              = batch.subspan(COMMAND_HEADER_SIZE);
+        if (batch.size() < length)
+        {
+            appendError(replies, ControlStatus::ERROR, "Truncated command payload");
+            return;
+        }
+
+        auto const payload = batch.first(length);
+        batch              = batch.subspan(length);
+
+        data.clear();
+        try
+        {
+            auto const status = execute(command, payload, data);
+            appendReply(replies, status, data);
+            if (status != ControlStatus::OK)
+            {
+                return;
+            }
+        }
+        catch (std::exception const& e)
+        {
+            appendError(replies, ControlStatus::ERROR, e.what());
+            return;
+        }
+    }
+}
+} // namespace fxb
\ No newline at end of file
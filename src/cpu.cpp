@@ -161,6 +161,7 @@ void Cpu::execute(std::uint8_t opcode)
             // follow the test suite for now
             tick();
             tick();
+            bus_->stop();
             break;
         }
         case 0x11:
@@ -3294,6 +3295,22 @@ void Cpu::setOnTickCallback(OnTickCallback callback)
     onTick = std::move(callback);
 }
 
+CpuState Cpu::state() const noexcept
+{
+    return {
+        .A  = A(),
+        .B  = B(),
+        .C  = C(),
+        .D  = D(),
+        .E  = E(),
+        .F  = F(),
+        .H  = H(),
+        .L  = L(),
+        .SP = SP(),
+        .PC = PC(),
+    };
+}
+
 void Cpu::reset(CpuState const& state)
 {
     A_  = state.A;
@@ -0,0 +1,106 @@
+#include "frame_pacer.hpp"
+
+#include <cerrno>
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <stdexcept>
+#include <utility>
+
+#include <time.h>
+
+namespace fxb
+{
+namespace
+{
+// steady_clock is CLOCK_MONOTONIC on Linux, so its time points work as absolute deadlines
+void sleepUntil(FramePacer::Clock::time_point deadline) noexcept
+{
+    auto const sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch());
+    auto const seconds    = std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch);
+
+    timespec target = {};
+    target.tv_sec   = static_cast<time_t>(seconds.count());
+    target.tv_nsec  = static_cast<long>((sinceEpoch - seconds).count());
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, nullptr) == EINTR)
+    {
+    }
+}
+} // namespace
+
+FramePacer::FramePacer(Clock::duration spinWindow, Timer timer)
+    : timer_(std::move(timer)),
+      spinWindow_(spinWindow)
+{
+    setSpeed(1.0);
+}
+
+FramePacer::Timer FramePacer::systemTimer()
+{
+    return {.now = [] { return Clock::now(); }, .sleepUntil = [](Clock::time_point deadline) { sleepUntil(deadline); }};
+}
+
+void FramePacer::setSpeed(double multiplier)
+{
+    if (!(multiplier > 0.0))
+    {
+        throw std::invalid_argument(std::format("Speed multiplier must be positive, got {}", multiplier));
+    }
+
+    auto const period = std::chrono::duration<double>(1.0 / (FRAME_RATE * multiplier));
+
+    speed_        = multiplier;
+    period_       = std::chrono::duration_cast<Clock::duration>(period);
+    deadline_     = (timer_.now() + period_);
+    skippedInRow_ = 0;
+}
+
+bool FramePacer::shouldRender() noexcept
+{
+    bool const behind = (timer_.now() > deadline_);
+    if (behind && (skippedInRow_ < MAX_SKIPPED_FRAMES))
+    {
+        ++skippedInRow_;
+        ++statistics_.skippedFrames;
+        return false;
+    }
+
+    skippedInRow_ = 0;
+    return true;
+}
+
+void FramePacer::wait() noexcept
+{
+    auto now = timer_.now();
+    ++statistics_.frames;
+    if (now >= deadline_)
+    {
+        // Lag of the host rather than error of the wakeup, kept out of the jitter
+        ++statistics_.lateFrames;
+    }
+    else
+    {
+        if (now < (deadline_ - spinWindow_))
+        {
+            timer_.sleepUntil(deadline_ - spinWindow_);
+            now = timer_.now();
+        }
+        while (now < deadline_)
+        {
+            now = timer_.now();
+        }
+
+        auto const jitter = std::chrono::duration_cast<std::chrono::nanoseconds>(now - deadline_);
+        statistics_.totalJitter += jitter;
+        statistics_.maxJitter = std::max(statistics_.maxJitter, jitter);
+    }
+
+    // Late frames keep their slot so the average rate holds, unless catching up would mean a burst of frames
+    deadline_ += period_;
+    if ((now - deadline_) > (MAX_LAG_FRAMES * period_))
+    {
+        deadline_ = (now + period_);
+        ++statistics_.resyncs;
+    }
+}
+} // namespace fxb
\ No newline at end of file
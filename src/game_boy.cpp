@@ -0,0 +1,168 @@
+#include "game_boy.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "cartridge.hpp"
+#include "cpu.hpp"
+#include "hash.hpp"
+#include "snapshot.hpp"
+
+namespace fxb
+{
+namespace
+{
+constexpr std::uint32_t SNAPSHOT_MAGIC   = 0x53425846;
+constexpr std::uint32_t SNAPSHOT_VERSION = 2;
+
+// Registers at 0x0100, A tells games which model they run on
+constexpr CpuState DMG_POST_BOOT_STATE = {
+    .A  = 0x01,
+    .B  = 0x00,
+    .C  = 0x13,
+    .D  = 0x00,
+    .E  = 0xD8,
+    .F  = 0xB0,
+    .H  = 0x01,
+    .L  = 0x4D,
+    .SP = 0xFFFE,
+    .PC = 0x0100,
+};
+
+constexpr CpuState CGB_POST_BOOT_STATE = {
+    .A  = 0x11,
+    .B  = 0x00,
+    .C  = 0x00,
+    .D  = 0xFF,
+    .E  = 0x56,
+    .F  = 0x80,
+    .H  = 0x00,
+    .L  = 0x0D,
+    .SP = 0xFFFE,
+    .PC = 0x0100,
+};
+} // namespace
+
+GameBoy::GameBoy(Cartridge cartridge)
+    : GameBoy(std::move(cartridge), {})
+{
+}
+
+GameBoy::GameBoy(Cartridge cartridge, std::vector<std::uint8_t> bootRom)
+    : mmu_(std::move(cartridge), std::move(bootRom))
+{
+    if (mmu_.bootRomMapped())
+    {
+        cpu_.reset();
+    }
+    else
+    {
+        mmu_.skipBootRom();
+        cpu_.reset(mmu_.cgb() ? CGB_POST_BOOT_STATE : DMG_POST_BOOT_STATE);
+    }
+
+    cpu_.setOnTickCallback(
+        [this](Cpu*)
+        {
+            mmu_.tick();
+            ++cycles_;
+        });
+}
+
+void GameBoy::step()
+{
+    cpu_.step();
+
+    // The cpu sits out HDMA transfers while the rest of the machine keeps running
+    while (auto stall = mmu_.takeStallCycles())
+    {
+        for (; stall > 0; --stall)
+        {
+            mmu_.tick();
+            ++cycles_;
+        }
+    }
+}
+
+void GameBoy::runFrame()
+{
+    auto const frame = mmu_.frames();
+    while (mmu_.frames() == frame)
+    {
+        step();
+    }
+}
+
+void GameBoy::save(SnapshotWriter& writer) const
+{
+    writer.write(SNAPSHOT_MAGIC);
+    writer.write(SNAPSHOT_VERSION);
+    writer.write(cpu_.state());
+    writer.write(cycles_);
+    mmu_.save(writer);
+}
+
+std::vector<std::uint8_t> GameBoy::save() const
+{
+    std::vector<std::uint8_t> snapshot;
+    save(snapshot);
+    return snapshot;
+}
+
+void GameBoy::save(std::vector<std::uint8_t>& snapshot) const
+{
+    snapshot.clear();
+    SnapshotWriter writer(snapshot);
+    save(writer);
+}
+
+std::uint64_t GameBoy::hash() const
+{
+    HashStream stream;
+    SnapshotWriter writer(stream);
+    save(writer);
+    return stream.digest();
+}
+
+void GameBoy::restore(std::span<std::uint8_t const> snapshot)
+{
+    SnapshotReader reader(snapshot);
+
+    std::uint32_t magic   = 0;
+    std::uint32_t version = 0;
+    reader.read(magic);
+    reader.read(version);
+    if ((magic != SNAPSHOT_MAGIC) || (version != SNAPSHOT_VERSION))
+    {
+        throw BadSnapshotException("Not a snapshot of this version");
+    }
+
+    CpuState state;
+    reader.read(state);
+    cpu_.reset(state);
+    reader.read(cycles_);
+    mmu_.load(reader);
+
+    if (!reader.empty())
+    {
+        throw BadSnapshotException("Trailing bytes after the snapshot");
+    }
+}
+
+// A snapshot of a different rom usually fails on the size of the cartridge RAM halfway through, the machine goes back
+// to where it was then
+void GameBoy::load(std::span<std::uint8_t const> snapshot)
+{
+    auto const backup = save();
+    try
+    {
+        restore(snapshot);
+    }
+    catch (...)
+    {
+        restore(backup);
+        throw;
+    }
+}
+} // namespace fxb
\ No newline at end of file
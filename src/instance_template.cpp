@@ -0,0 +1,32 @@
+#include "instance_template.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace fxb
+{
+// Only a boot ROM that is still mapped and the cheats have to come along, the snapshot holds everything else
+InstanceTemplate::InstanceTemplate(GameBoy const& source)
+    : cartridge_(source.mmu().cartridge()),
+      snapshot_(source.save()),
+      romPatches_(source.mmu().romPatches().begin(), source.mmu().romPatches().end()),
+      ramPokes_(source.mmu().ramPokes().begin(), source.mmu().ramPokes().end())
+{
+    if (source.mmu().bootRomMapped())
+    {
+        auto const bootRom = source.mmu().bootRom();
+        bootRom_.assign(bootRom.begin(), bootRom.end());
+    }
+}
+
+// restore() instead of load() skips taking a backup, the snapshot came from a machine of the same rom
+std::unique_ptr<GameBoy> InstanceTemplate::spawn() const
+{
+    auto gameBoy = std::make_unique<GameBoy>(cartridge_, bootRom_);
+    gameBoy->mmu().setRomPatches(romPatches_);
+    gameBoy->mmu().setRamPokes(ramPokes_);
+    gameBoy->restore(snapshot_);
+    return gameBoy;
+}
+} // namespace fxb
\ No newline at end of file
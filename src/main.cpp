@@ -1,3 +1,217 @@
-int main()
+// Headless instance driven through the binary protocol of control.hpp, batches arrive on stdin and replies go to
+// stdout unless a Unix socket is given. Connections to the socket are served one after another and share the machine
+//
+// usage: fauxboy [--socket PATH]
+
+#include <cstdint>
+#include <cstdlib>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <array>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <fauxboy/control.hpp>
+
+using namespace fxb;
+
+namespace
 {
+struct Options
+{
+    std::optional<std::string> socket;
+};
+
+Options parseOptions(int argc, char* argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view const arg = argv[i];
+
+        if (arg == "--socket")
+        {
+            if ((i + 1) >= argc)
+            {
+                throw std::invalid_argument(std::format("Missing value for {}", arg));
+            }
+            options.socket = argv[++i];
+        }
+        else
+        {
+            throw std::invalid_argument("usage: fauxboy [--socket PATH]");
+        }
+    }
+    return options;
+}
+
+// False when the peer closed the stream before the first byte
+bool readExactly(int fd, std::span<std::uint8_t> bytes)
+{
+    std::size_t done = 0;
+    while (done < bytes.size())
+    {
+        auto const count = read(fd, (bytes.data() + done), (bytes.size() - done));
+        if ((count < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        if (count < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "Could not read a batch");
+        }
+        if (count == 0)
+        {
+            if (done == 0)
+            {
+                return false;
+            }
+            throw std::runtime_error("Stream ended inside a batch");
+        }
+        done += static_cast<std::size_t>(count);
+    }
+    return true;
+}
+
+void writeAll(int fd, std::span<std::uint8_t const> bytes)
+{
+    while (!bytes.empty())
+    {
+        auto const count = write(fd, bytes.data(), bytes.size());
+        if ((count < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        if (count < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "Could not write a reply");
+        }
+        bytes = bytes.subspan(static_cast<std::size_t>(count));
+    }
+}
+
+// One read and one write per batch, replies are gathered behind a placeholder for their length
+void serve(ControlSession& session, int input, int output)
+{
+    std::vector<std::uint8_t> batch;
+    std::vector<std::uint8_t> replies;
+
+    std::array<std::uint8_t, 4> prefix = {};
+    while (readExactly(input, prefix))
+    {
+        auto const length = (std::uint32_t{prefix[0]} | (std::uint32_t{prefix[1]} << 8) |
+                             (std::uint32_t{prefix[2]} << 16) | (std::uint32_t{prefix[3]} << 24));
+        if (length > ControlSession::MAX_BATCH_SIZE)
+        {
+            throw std::runtime_error(std::format("Batch of {} bytes exceeds the limit", length));
+        }
+
+        batch.resize(length);
+        if ((length > 0) && !readExactly(input, batch))
+        {
+            throw std::runtime_error("Stream ended inside a batch");
+        }
+
+        replies.assign(prefix.size(), 0);
+        session.handle(batch, replies);
+
+        auto const replyLength = static_cast<std::uint32_t>(replies.size() - prefix.size());
+        for (std::size_t i = 0; i < prefix.size(); ++i)
+        {
+            replies[i] = static_cast<std::uint8_t>(replyLength >> (8 * i));
+        }
+        writeAll(output, replies);
+    }
+}
+
+int listenOn(std::string const& path)
+{
+    sockaddr_un address = {};
+    address.sun_family  = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        throw std::invalid_argument(std::format("Socket path too long: {}", path));
+    }
+    std::strncpy(address.sun_path, path.c_str(), (sizeof(address.sun_path) - 1));
+
+    auto const fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "Could not create a socket");
+    }
+
+    unlink(path.c_str());
+    if ((bind(fd, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0) || (listen(fd, 1) != 0))
+    {
+        auto const error = errno;
+        close(fd);
+        throw std::system_error(error, std::generic_category(), std::format("Could not listen on {}", path));
+    }
+    return fd;
+}
+
+int run(Options const& options)
+{
+    ControlSession session;
+
+    if (!options.socket)
+    {
+        serve(session, STDIN_FILENO, STDOUT_FILENO);
+        return EXIT_SUCCESS;
+    }
+
+    // A client that hangs up early must not take the instance down with it
+    std::signal(SIGPIPE, SIG_IGN);
+
+    auto const listener = listenOn(*options.socket);
+    while (true)
+    {
+        auto const connection = accept(listener, nullptr, nullptr);
+        if (connection < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "Could not accept a connection");
+        }
+
+        // A broken connection only ends that client
+        try
+        {
+            serve(session, connection, connection);
+        }
+        catch (std::exception const& e)
+        {
+            std::cerr << e.what() << '\n';
+        }
+        close(connection);
+    }
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        return run(parseOptions(argc, argv));
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,643 @@
+#include "mmu.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <format>
+#include <stdexcept>
+#include <utility>
+
+#include "address.hpp"
+#include "cartridge.hpp"
+#include "util.hpp"
+
+namespace fxb
+{
+namespace
+{
+constexpr std::uint8_t JOYP  = 0x00;
+constexpr std::uint8_t SB    = 0x01;
+constexpr std::uint8_t SC    = 0x02;
+constexpr std::uint8_t DIV   = 0x04;
+constexpr std::uint8_t TAC   = 0x07;
+constexpr std::uint8_t IF    = 0x0F;
+constexpr std::uint8_t NR10  = 0x10;
+constexpr std::uint8_t LCDC  = 0x40;
+constexpr std::uint8_t STAT  = 0x41;
+constexpr std::uint8_t LY    = 0x44;
+constexpr std::uint8_t LYC   = 0x45;
+constexpr std::uint8_t DMA   = 0x46;
+constexpr std::uint8_t BGP   = 0x47;
+constexpr std::uint8_t OBP0  = 0x48;
+constexpr std::uint8_t OBP1  = 0x49;
+constexpr std::uint8_t KEY1  = 0x4D;
+constexpr std::uint8_t VBK   = 0x4F;
+constexpr std::uint8_t BANK  = 0x50;
+constexpr std::uint8_t HDMA1 = 0x51;
+constexpr std::uint8_t HDMA2 = 0x52;
+constexpr std::uint8_t HDMA3 = 0x53;
+constexpr std::uint8_t HDMA4 = 0x54;
+constexpr std::uint8_t HDMA5 = 0x55;
+constexpr std::uint8_t BCPS  = 0x68;
+constexpr std::uint8_t BCPD  = 0x69;
+constexpr std::uint8_t OCPS  = 0x6A;
+constexpr std::uint8_t OCPD  = 0x6B;
+constexpr std::uint8_t SVBK  = 0x70;
+
+constexpr std::uint8_t STAT_COINCIDENCE        = (1u << 2);
+constexpr std::uint8_t STAT_COINCIDENCE_SELECT = (1u << 6);
+
+constexpr std::size_t HDMA_BLOCK_SIZE = 16;
+
+[[nodiscard]] constexpr bool isCgbRegister(std::uint8_t offset) noexcept
+{
+    return ((offset == KEY1) || (offset == VBK) || ((offset >= HDMA1) && (offset <= HDMA5)) ||
+            ((offset >= BCPS) && (offset <= OCPD)) || (offset == SVBK));
+}
+} // namespace
+
+Mmu::Mmu(Cartridge cartridge, std::vector<std::uint8_t> bootRom)
+    : cartridge_(std::move(cartridge)),
+      cgb_(cartridge_.supportsCgb()),
+      bootRom_(std::move(bootRom)),
+      bootRomMapped_(!bootRom_.empty())
+{
+    if (bootRomMapped_ && (bootRom_.size() != DMG_BOOT_ROM_SIZE) && (bootRom_.size() != CGB_BOOT_ROM_SIZE))
+    {
+        throw std::invalid_argument(std::format("Boot ROM has {} bytes, expected {} or {}",
+                                                bootRom_.size(),
+                                                DMG_BOOT_ROM_SIZE,
+                                                CGB_BOOT_ROM_SIZE));
+    }
+
+    mapCartridge();
+    mapVram();
+    mapWram();
+
+    io_[JOYP] = 0x30;
+    io_[SB]   = 0xFF;
+}
+
+void Mmu::mapPages(std::size_t firstPage, std::size_t count, std::uint8_t const* read, std::uint8_t* write) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        readPages_[firstPage + i]  = ((read != nullptr) ? (read + (i * PAGE_SIZE)) : nullptr);
+        writePages_[firstPage + i] = ((write != nullptr) ? (write + (i * PAGE_SIZE)) : nullptr);
+    }
+}
+
+// Rom pages are never writable, writes to them go to the bank controller
+void Mmu::mapCartridge() noexcept
+{
+    constexpr auto ROM_PAGES = (Cartridge::ROM_BANK_SIZE / PAGE_SIZE);
+    constexpr auto RAM_PAGES = (Cartridge::RAM_BANK_SIZE / PAGE_SIZE);
+
+    mapPages(0x00, ROM_PAGES, cartridge_.lowerRomBank().data(), nullptr);
+    mapPages(0x40, ROM_PAGES, cartridge_.upperRomBank().data(), nullptr);
+    patchRomPages();
+
+    // Laid over the rom until 0xFF50 unmaps it, the cartridge header page stays visible
+    if (bootRomMapped_)
+    {
+        mapPages(0x00, 1, bootRom_.data(), nullptr);
+        if (bootRom_.size() == CGB_BOOT_ROM_SIZE)
+        {
+            mapPages(0x02, ((CGB_BOOT_ROM_SIZE / PAGE_SIZE) - 2), (bootRom_.data() + (2 * PAGE_SIZE)), nullptr);
+        }
+    }
+
+    auto const ram = cartridge_.ramBank();
+    mapPages(0xA0, RAM_PAGES, ram.data(), ram.data());
+}
+
+// Runs on every bank switch, the copies follow the newly mapped banks and a compare byte picks the banks a patch
+// applies to
+void Mmu::patchRomPages() noexcept
+{
+    auto copy = patchedPages_.begin();
+    for (auto patch = romPatches_.begin(); patch != romPatches_.end(); ++copy)
+    {
+        auto const page = getUpper(patch->address);
+        std::memcpy(copy->data(), readPages_[page], PAGE_SIZE);
+
+        for (; (patch != romPatches_.end()) && (getUpper(patch->address) == page); ++patch)
+        {
+            auto& byte = (*copy)[getLower(patch->address)];
+            if (!patch->compare || (*patch->compare == byte))
+            {
+                byte = patch->value;
+            }
+        }
+        readPages_[page] = copy->data();
+    }
+}
+
+// Only RAM is reachable here, parseGameShark() rejects every other address
+void Mmu::applyRamPokes() noexcept
+{
+    for (auto const& poke : ramPokes_)
+    {
+        if (poke.wramBank)
+        {
+            auto const bank = std::max<std::size_t>(*poke.wramBank, 1);
+            wram_[(bank * WRAM_BANK_SIZE) + (poke.address - 0xD000)] = poke.value;
+        }
+        else if (auto* page = writePages_[getUpper(poke.address)])
+        {
+            page[getLower(poke.address)] = poke.value;
+        }
+        else if ((poke.address >= 0xFF80) && (poke.address < 0xFFFF))
+        {
+            hram_[poke.address - 0xFF80] = poke.value;
+        }
+    }
+}
+
+void Mmu::mapVram() noexcept
+{
+    auto* const bank = (vram_.data() + (vramBank_ * VRAM_BANK_SIZE));
+    mapPages(0x80, (VRAM_BANK_SIZE / PAGE_SIZE), bank, bank);
+}
+
+// 0xC000 is always bank 0, 0xD000 the one selected through SVBK, 0xE000-0xFDFF echoes both
+void Mmu::mapWram() noexcept
+{
+    constexpr auto BANK_PAGES = (WRAM_BANK_SIZE / PAGE_SIZE);
+
+    auto* const bank = (wram_.data() + (wramBank_ * WRAM_BANK_SIZE));
+    mapPages(0xC0, BANK_PAGES, wram_.data(), wram_.data());
+    mapPages(0xD0, BANK_PAGES, bank, bank);
+    mapPages(0xE0, BANK_PAGES, wram_.data(), wram_.data());
+    mapPages(0xF0, 0x0E, bank, bank);
+}
+
+// Whatever the source pages point at is copied a page at a time, only sources without a page take the slow path byte
+// by byte. The destination wraps around within the selected VRAM bank
+void Mmu::copyHdmaBlocks(std::size_t blocks) noexcept
+{
+    auto* const bank = (vram_.data() + (vramBank_ * VRAM_BANK_SIZE));
+
+    auto remaining = (blocks * HDMA_BLOCK_SIZE);
+    while (remaining > 0)
+    {
+        auto const offset = (hdmaDestination_ % VRAM_BANK_SIZE);
+        auto const length = std::min({remaining, (PAGE_SIZE - getLower(hdmaSource_)), (VRAM_BANK_SIZE - offset)});
+
+        if (auto const* page = readPages_[getUpper(hdmaSource_)])
+        {
+            std::memcpy((bank + offset), (page + getLower(hdmaSource_)), length);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                bank[offset + i] = readSlow(Address(static_cast<std::uint16_t>(hdmaSource_ + i)));
+            }
+        }
+
+        hdmaSource_      = static_cast<std::uint16_t>(hdmaSource_ + length);
+        hdmaDestination_ = static_cast<std::uint16_t>((offset + length) % VRAM_BANK_SIZE);
+        remaining -= length;
+    }
+
+    // 8 m-cycles per block at single speed, the transfer takes the same real time in double speed
+    stallCycles_ += static_cast<std::uint32_t>(blocks * (doubleSpeed_ ? 16 : 8));
+}
+
+std::uint8_t Mmu::readSlow(Address address)
+{
+    auto const value = address.value;
+    if (value < 0xFE00)
+    {
+        // Disabled or missing cartridge ram
+        return 0xFF;
+    }
+    if (value < 0xFEA0)
+    {
+        return oam_[value - 0xFE00];
+    }
+    if (value < 0xFF00)
+    {
+        return 0x00;
+    }
+    if (value < 0xFF80)
+    {
+        return readIo(getLower(value));
+    }
+    if (value < 0xFFFF)
+    {
+        return hram_[value - 0xFF80];
+    }
+    return interruptEnable_;
+}
+
+void Mmu::writeSlow(Address address, std::uint8_t value)
+{
+    auto const target = address.value;
+    if (target < 0x8000)
+    {
+        cartridge_.writeControl(address, value);
+        mapCartridge();
+    }
+    else if (target < 0xFE00)
+    {
+        // Disabled or missing cartridge ram
+    }
+    else if (target < 0xFEA0)
+    {
+        oam_[target - 0xFE00] = value;
+    }
+    else if (target < 0xFF00)
+    {
+        // Unusable
+    }
+    else if (target < 0xFF80)
+    {
+        writeIo(getLower(target), value);
+    }
+    else if (target < 0xFFFF)
+    {
+        hram_[target - 0xFF80] = value;
+    }
+    else
+    {
+        interruptEnable_ = value;
+    }
+}
+
+std::uint8_t Mmu::readIo(std::uint8_t offset) const noexcept
+{
+    if (!cgb_ && isCgbRegister(offset))
+    {
+        return 0xFF;
+    }
+
+    switch (offset)
+    {
+        case JOYP: return readJoypad();
+        case SC: return (0x7E | io_[SC]);
+        case DIV: return getUpper(divider_);
+        case IF: return (0xE0 | io_[IF]);
+        case KEY1: return static_cast<std::uint8_t>(0x7E | (doubleSpeed_ ? 0x80 : 0x00) | (speedSwitchArmed_ ? 1 : 0));
+        case VBK: return (0xFE | vramBank_);
+        case BANK: return 0xFF;
+        // The source and destination can not be read back
+        case HDMA1:
+        case HDMA2:
+        case HDMA3:
+        case HDMA4: return 0xFF;
+        // Bit 7 is clear while an HBlank transfer runs, 0xFF once it completed
+        case HDMA5: return static_cast<std::uint8_t>((hdmaActive_ ? 0x00 : 0x80) | ((hdmaBlocks_ - 1) & 0x7F));
+        case BCPS: return palettes_.backgroundSpec();
+        case BCPD: return palettes_.backgroundData();
+        case OCPS: return palettes_.objectSpec();
+        case OCPD: return palettes_.objectData();
+        case SVBK: return (0xF8 | io_[SVBK]);
+        default: return io_[offset];
+    }
+}
+
+// Pressed buttons read as 0, a group is only visible while its select bit is cleared
+std::uint8_t Mmu::readJoypad() const noexcept
+{
+    std::uint8_t pressed = 0;
+    if ((io_[JOYP] & 0x10) == 0)
+    {
+        pressed |= (buttons_ >> 4);
+    }
+    if ((io_[JOYP] & 0x20) == 0)
+    {
+        pressed |= (buttons_ & 0x0F);
+    }
+    return static_cast<std::uint8_t>(0xC0 | io_[JOYP] | (~pressed & 0x0F));
+}
+
+void Mmu::writeIo(std::uint8_t offset, std::uint8_t value)
+{
+    if (!cgb_ && isCgbRegister(offset))
+    {
+        return;
+    }
+
+    switch (offset)
+    {
+        case JOYP:
+        {
+            io_[JOYP] = (value & 0x30);
+            break;
+        }
+        case SC:
+        {
+            // Only transfers on the internal clock complete, there is never anything on the other end of the link
+            if ((value & 0x81) == 0x81)
+            {
+                if (onSerial)
+                {
+                    onSerial(io_[SB]);
+                }
+                io_[SB] = 0xFF;
+                value &= 0x7F;
+                requestInterrupt(INTERRUPT_SERIAL);
+            }
+            io_[SC] = value;
+            break;
+        }
+        case DIV:
+        {
+            divider_ = 0;
+            break;
+        }
+        case LY: break;
+        case KEY1:
+        {
+            speedSwitchArmed_ = ((value & 0x01) != 0);
+            break;
+        }
+        case VBK:
+        {
+            vramBank_ = (value & 0x01);
+            mapVram();
+            break;
+        }
+        case BANK:
+        {
+            // Only the page table changes, the boot ROM can not be mapped again
+            if (bootRomMapped_ && (value != 0))
+            {
+                bootRomMapped_ = false;
+                mapCartridge();
+            }
+            break;
+        }
+        case HDMA1:
+        {
+            setUpper(hdmaSource_, value);
+            break;
+        }
+        case HDMA2:
+        {
+            setLower(hdmaSource_, (value & 0xF0));
+            break;
+        }
+        case HDMA3:
+        {
+            setUpper(hdmaDestination_, (value & 0x1F));
+            break;
+        }
+        case HDMA4:
+        {
+            setLower(hdmaDestination_, (value & 0xF0));
+            break;
+        }
+        case HDMA5:
+        {
+            // Clearing bit 7 during an HBlank transfer cancels it, otherwise bit 7 picks between a general purpose
+            // transfer that completes right away and one block per HBlank
+            if (hdmaActive_ && ((value & 0x80) == 0))
+            {
+                hdmaActive_ = false;
+                break;
+            }
+
+            auto const blocks = static_cast<std::uint8_t>((value & 0x7F) + 1);
+            if ((value & 0x80) != 0)
+            {
+                hdmaBlocks_ = blocks;
+                hdmaActive_ = true;
+            }
+            else
+            {
+                copyHdmaBlocks(blocks);
+                hdmaBlocks_ = 0;
+            }
+            break;
+        }
+        case BCPS:
+        {
+            palettes_.setBackgroundSpec(value);
+            break;
+        }
+        case BCPD:
+        {
+            palettes_.writeBackgroundData(value);
+            break;
+        }
+        case OCPS:
+        {
+            palettes_.setObjectSpec(value);
+            break;
+        }
+        case OCPD:
+        {
+            palettes_.writeObjectData(value);
+            break;
+        }
+        case SVBK:
+        {
+            io_[SVBK] = (value & 0x07);
+            wramBank_ = std::max<std::uint8_t>(io_[SVBK], 1);
+            mapWram();
+            break;
+        }
+        default:
+        {
+            io_[offset] = value;
+            break;
+        }
+    }
+}
+
+void Mmu::setOnSerialCallback(OnSerialCallback callback)
+{
+    onSerial = std::move(callback);
+}
+
+void Mmu::setRomPatches(std::vector<RomPatch> patches)
+{
+    for (auto const& patch : patches)
+    {
+        if (patch.address >= 0x8000)
+        {
+            throw std::invalid_argument(std::format("Rom patch at {:#06x} lies outside the rom", patch.address));
+        }
+    }
+    std::ranges::sort(patches, {}, &RomPatch::address);
+
+    std::size_t pages = 0;
+    for (std::size_t i = 0; i < patches.size(); ++i)
+    {
+        if ((i == 0) || (getUpper(patches[i].address) != getUpper(patches[i - 1].address)))
+        {
+            ++pages;
+        }
+    }
+
+    // Allocated before anything changes, the patches and their copies must never disagree in count
+    std::vector<std::array<std::uint8_t, PAGE_SIZE>> patchedPages(pages);
+    romPatches_.swap(patches);
+    patchedPages_.swap(patchedPages);
+    mapCartridge();
+}
+
+void Mmu::setRamPokes(std::vector<RamPoke> pokes)
+{
+    ramPokes_ = std::move(pokes);
+}
+
+void Mmu::setButtons(std::uint8_t pressed) noexcept
+{
+    if ((pressed & ~buttons_) != 0)
+    {
+        requestInterrupt(INTERRUPT_JOYPAD);
+    }
+    buttons_ = pressed;
+}
+
+// The sound registers only matter for reads while there is no APU. The CGB leaves DIV depending on how long the logo
+// animation ran, which varies with the header, so it stays at 0 there
+void Mmu::skipBootRom() noexcept
+{
+    // NR10 to NR52
+    constexpr std::array<std::uint8_t, 0x17> SOUND = {
+        0x80, 0xBF, 0xF3, 0xFF, 0xBF, 0xFF, 0x3F, 0x00, 0xFF, 0xBF, 0x7F, 0xFF,
+        0x9F, 0xFF, 0xBF, 0xFF, 0xFF, 0x00, 0x00, 0xBF, 0x77, 0xF3, 0xF1,
+    };
+    std::ranges::copy(SOUND, (io_.begin() + NR10));
+
+    io_[TAC]  = 0xF8;
+    io_[IF]   = 0x01;
+    io_[LCDC] = 0x91;
+    io_[STAT] = 0x85;
+    io_[DMA]  = (cgb_ ? 0x00 : 0xFF);
+    io_[BGP]  = 0xFC;
+    io_[OBP0] = 0xFF;
+    io_[OBP1] = 0xFF;
+
+    if (!cgb_)
+    {
+        divider_ = 0xABCC;
+    }
+    bootRomMapped_ = false;
+    mapCartridge();
+}
+
+void Mmu::stop() noexcept
+{
+    if (cgb_ && speedSwitchArmed_)
+    {
+        doubleSpeed_      = !doubleSpeed_;
+        speedSwitchArmed_ = false;
+        divider_          = 0;
+    }
+}
+
+// The divider follows the cpu clock while the LCD keeps its pace in double speed mode
+void Mmu::tick() noexcept
+{
+    divider_ += 4;
+
+    auto const previousDots = lineDots_;
+    lineDots_ += (doubleSpeed_ ? 2 : 4);
+
+    bool const visibleLine = (io_[LY] < VBLANK_LINE);
+    if (hdmaActive_ && visibleLine && (previousDots < HBLANK_DOT) && (lineDots_ >= HBLANK_DOT))
+    {
+        copyHdmaBlocks(1);
+        hdmaActive_ = (--hdmaBlocks_ != 0);
+    }
+
+    if (lineDots_ < DOTS_PER_LINE)
+    {
+        return;
+    }
+    lineDots_ -= DOTS_PER_LINE;
+
+    io_[LY] = static_cast<std::uint8_t>((io_[LY] + 1) % LINES_PER_FRAME);
+    if (io_[LY] == 0)
+    {
+        ++frames_;
+    }
+    if (io_[LY] == VBLANK_LINE)
+    {
+        applyRamPokes();
+        requestInterrupt(INTERRUPT_VBLANK);
+    }
+
+    bool const coincidence = (io_[LY] == io_[LYC]);
+    io_[STAT]              = ((io_[STAT] & ~STAT_COINCIDENCE) | (coincidence ? STAT_COINCIDENCE : 0));
+    if (coincidence && ((io_[STAT] & STAT_COINCIDENCE_SELECT) != 0))
+    {
+        requestInterrupt(INTERRUPT_STAT);
+    }
+}
+
+void Mmu::save(SnapshotWriter& writer) const
+{
+    writer.write(bootRomMapped_);
+    cartridge_.save(writer);
+    palettes_.save(writer);
+
+    writer.write(vram_);
+    writer.write(wram_);
+    writer.write(oam_);
+    writer.write(io_);
+    writer.write(hram_);
+    writer.write(interruptEnable_);
+
+    writer.write(vramBank_);
+    writer.write(wramBank_);
+    writer.write(doubleSpeed_);
+    writer.write(speedSwitchArmed_);
+
+    writer.write(hdmaSource_);
+    writer.write(hdmaDestination_);
+    writer.write(hdmaBlocks_);
+    writer.write(hdmaActive_);
+    writer.write(stallCycles_);
+
+    writer.write(divider_);
+    writer.write(lineDots_);
+    writer.write(frames_);
+    writer.write(buttons_);
+}
+
+void Mmu::load(SnapshotReader& reader)
+{
+    reader.read(bootRomMapped_);
+    if (bootRomMapped_ && bootRom_.empty())
+    {
+        throw BadSnapshotException("Snapshot needs a boot ROM");
+    }
+    cartridge_.load(reader);
+    palettes_.load(reader);
+
+    reader.read(vram_);
+    reader.read(wram_);
+    reader.read(oam_);
+    reader.read(io_);
+    reader.read(hram_);
+    reader.read(interruptEnable_);
+
+    reader.read(vramBank_);
+    reader.read(wramBank_);
+    reader.read(doubleSpeed_);
+    reader.read(speedSwitchArmed_);
+
+    reader.read(hdmaSource_);
+    reader.read(hdmaDestination_);
+    reader.read(hdmaBlocks_);
+    reader.read(hdmaActive_);
+    reader.read(stallCycles_);
+
+    reader.read(divider_);
+    reader.read(lineDots_);
+    reader.read(frames_);
+    reader.read(buttons_);
+
+    mapCartridge();
+    mapVram();
+    mapWram();
+}
+} // namespace fxb
\ No newline at end of file
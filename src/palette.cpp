@@ -0,0 +1,99 @@
+#include "palette.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+namespace fxb
+{
+namespace
+{
+[[nodiscard]] constexpr std::uint32_t widen(std::uint32_t channel) noexcept
+{
+    return ((channel << 3) | (channel >> 2));
+}
+} // namespace
+
+HostColor toHostColor(std::uint16_t bgr555, ColorCorrection correction) noexcept
+{
+    std::uint32_t const r = (bgr555 & 0x1F);
+    std::uint32_t const g = ((bgr555 >> 5) & 0x1F);
+    std::uint32_t const b = ((bgr555 >> 10) & 0x1F);
+
+    std::uint32_t red   = 0;
+    std::uint32_t green = 0;
+    std::uint32_t blue  = 0;
+    switch (correction)
+    {
+        case ColorCorrection::NONE:
+        {
+            red   = widen(r);
+            green = widen(g);
+            blue  = widen(b);
+            break;
+        }
+        case ColorCorrection::LCD:
+        {
+            // Gambatte's channel mix, every output stays within 0-248
+            red   = (((r * 13) + (g * 2) + b) >> 1);
+            green = (((g * 3) + b) << 1);
+            blue  = (((r * 3) + (g * 2) + (b * 11)) >> 1);
+            break;
+        }
+    }
+
+    return (0xFF000000u | (red << 16) | (green << 8) | blue);
+}
+
+// Powers on with every color white
+PaletteRam::PaletteRam() noexcept
+{
+    raw_.fill(0xFF);
+    for (auto i = 1u; i < raw_.size(); i += 2)
+    {
+        raw_[i] = 0x7F;
+    }
+    setColorCorrection(correction_);
+}
+
+void PaletteRam::writeData(std::size_t table, std::uint8_t value) noexcept
+{
+    auto& spec        = specs_[table];
+    auto const offset = ((table * 2 * COLORS) + (spec & 0x3F));
+
+    raw_[offset] = value;
+    updateHostColor(offset / 2);
+
+    if ((spec & 0x80) != 0)
+    {
+        spec = static_cast<std::uint8_t>(0x80 | ((spec + 1) & 0x3F));
+    }
+}
+
+void PaletteRam::updateHostColor(std::size_t color) noexcept
+{
+    auto const bgr555  = static_cast<std::uint16_t>(raw_[2 * color] | (raw_[(2 * color) + 1] << 8));
+    hostColors_[color] = toHostColor(bgr555, correction_);
+}
+
+void PaletteRam::setColorCorrection(ColorCorrection correction) noexcept
+{
+    correction_ = correction;
+    for (std::size_t color = 0; color < HOST_COLORS; ++color)
+    {
+        updateHostColor(color);
+    }
+}
+
+void PaletteRam::save(SnapshotWriter& writer) const
+{
+    writer.write(raw_);
+    writer.write(specs_);
+}
+
+void PaletteRam::load(SnapshotReader& reader)
+{
+    reader.read(raw_);
+    reader.read(specs_);
+    setColorCorrection(correction_);
+}
+} // namespace fxb
\ No newline at end of file
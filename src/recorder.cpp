@@ -0,0 +1,296 @@
+#include "recorder.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "frame.hpp"
+#include "hash.hpp"
+
+namespace fxb
+{
+namespace
+{
+constexpr std::size_t WAV_HEADER_SIZE = 44;
+
+std::ofstream openOutput(std::filesystem::path const& path)
+{
+    auto ofs = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open())
+    {
+        throw std::runtime_error(std::format("Could not open file: {}", path.c_str()));
+    }
+    return ofs;
+}
+
+template <std::integral T>
+void writeLittleEndian(std::ofstream& ofs, T value)
+{
+    if constexpr (std::endian::native == std::endian::big)
+    {
+        value = std::byteswap(value);
+    }
+    ofs.write(reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+// The sizes are patched in once the recording is finished
+void writeWavHeader(std::ofstream& ofs, Recorder::Options const& options, std::uint32_t dataSize)
+{
+    constexpr std::uint16_t PCM             = 1;
+    constexpr std::uint16_t BITS_PER_SAMPLE = 16;
+
+    auto const blockAlign = static_cast<std::uint16_t>(options.channels * (BITS_PER_SAMPLE / 8));
+
+    ofs.seekp(0);
+    ofs.write("RIFF", 4);
+    writeLittleEndian<std::uint32_t>(ofs, (dataSize + WAV_HEADER_SIZE - 8));
+    ofs.write("WAVEfmt ", 8);
+    writeLittleEndian<std::uint32_t>(ofs, 16);
+    writeLittleEndian<std::uint16_t>(ofs, PCM);
+    writeLittleEndian<std::uint16_t>(ofs, options.channels);
+    writeLittleEndian<std::uint32_t>(ofs, options.sampleRate);
+    writeLittleEndian<std::uint32_t>(ofs, (options.sampleRate * blockAlign));
+    writeLittleEndian<std::uint16_t>(ofs, blockAlign);
+    writeLittleEndian<std::uint16_t>(ofs, BITS_PER_SAMPLE);
+    ofs.write("data", 4);
+    writeLittleEndian<std::uint32_t>(ofs, dataSize);
+}
+
+// Full range BT.601 in three 4:4:4 planes, subsampling the chroma would smear single pixel details
+void toYuv444(HostFramebuffer const& pixels, std::span<std::uint8_t> planes) noexcept
+{
+    auto* const y = planes.data();
+    auto* const u = (y + SCREEN_PIXELS);
+    auto* const v = (u + SCREEN_PIXELS);
+
+    for (std::size_t i = 0; i < SCREEN_PIXELS; ++i)
+    {
+        auto const r = static_cast<std::int32_t>((pixels[i] >> 16) & 0xFF);
+        auto const g = static_cast<std::int32_t>((pixels[i] >> 8) & 0xFF);
+        auto const b = static_cast<std::int32_t>(pixels[i] & 0xFF);
+
+        y[i] = static_cast<std::uint8_t>(((77 * r) + (150 * g) + (29 * b) + 128) >> 8);
+        u[i] = static_cast<std::uint8_t>((((-43 * r) - (85 * g) + (128 * b) + 128) >> 8) + 128);
+        v[i] = static_cast<std::uint8_t>((((128 * r) - (107 * g) - (21 * b) + 128) >> 8) + 128);
+    }
+}
+} // namespace
+
+Recorder::Recorder(Options options)
+    : options_(std::move(options)),
+      video_(openOutput(options_.video)),
+      queue_(std::make_unique<SpscQueue<Message, QUEUE_CAPACITY>>())
+{
+    if (!options_.audio.empty())
+    {
+        audio_ = openOutput(options_.audio);
+        writeWavHeader(audio_, options_, 0);
+    }
+
+    video_ << std::format("YUV4MPEG2 W{} H{} F{}:{} Ip A1:1 C444 XCOLORRANGE=FULL\n",
+                          SCREEN_WIDTH,
+                          SCREEN_HEIGHT,
+                          options_.frameRateNumerator,
+                          options_.frameRateDenominator);
+
+    writer_ = std::jthread([this] { run(); });
+}
+
+Recorder::~Recorder()
+{
+    try
+    {
+        close();
+    }
+    catch (...)
+    {
+        // Errors only surface through an explicit close()
+    }
+}
+
+template <typename Fill>
+void Recorder::push(Fill&& fill)
+{
+    while (!queue_->tryPush(fill))
+    {
+        queue_->waitForRoom();
+    }
+}
+
+void Recorder::flushRepeats()
+{
+    if (pendingRepeats_ == 0)
+    {
+        return;
+    }
+
+    push([count = pendingRepeats_](Message& message) { message = Repeat{.count = count}; });
+    pendingRepeats_ = 0;
+}
+
+void Recorder::pushFrame(HostFramebuffer const& frame)
+{
+    auto const bytes = std::span(reinterpret_cast<std::uint8_t const*>(frame.data()), sizeof(frame));
+    auto const hash  = hashBytes(bytes);
+    if (hasFrame_ && (hash == lastHash_))
+    {
+        ++pendingRepeats_;
+        return;
+    }
+
+    flushRepeats();
+    // Slots keep their last alternative, a slot that held a frame before is overwritten in place
+    push(
+        [&frame](Message& message)
+        {
+            auto* slot = std::get_if<Frame>(&message);
+            if (slot == nullptr)
+            {
+                slot = &message.emplace<Frame>();
+            }
+            slot->pixels = frame;
+        });
+
+    lastHash_ = hash;
+    hasFrame_ = true;
+}
+
+void Recorder::pushAudio(std::span<std::int16_t const> samples)
+{
+    if (!audio_.is_open())
+    {
+        return;
+    }
+
+    while (!samples.empty())
+    {
+        auto const chunk = samples.first(std::min(samples.size(), MAX_AUDIO_SAMPLES));
+        push(
+            [chunk](Message& message)
+            {
+                auto* slot = std::get_if<Audio>(&message);
+                if (slot == nullptr)
+                {
+                    slot = &message.emplace<Audio>();
+                }
+                std::ranges::copy(chunk, slot->samples.begin());
+                slot->size = chunk.size();
+            });
+        samples = samples.subspan(chunk.size());
+    }
+}
+
+void Recorder::close()
+{
+    if (closed_)
+    {
+        return;
+    }
+    closed_ = true;
+
+    flushRepeats();
+    push([](Message& message) { message = Stop{}; });
+    writer_.join();
+
+    if (error_)
+    {
+        std::rethrow_exception(error_);
+    }
+}
+
+// After the first error the queue is still drained so the producer never stalls, only nothing gets written anymore
+void Recorder::run() noexcept
+{
+    constexpr std::string_view FRAME_HEADER = "FRAME\n";
+
+    std::vector<std::uint8_t> planes((3 * SCREEN_PIXELS), 0);
+    std::uint64_t audioBytes = 0;
+
+    auto const writeFrame = [&]
+    {
+        video_.write(FRAME_HEADER.data(), static_cast<std::streamsize>(FRAME_HEADER.size()));
+        video_.write(reinterpret_cast<char const*>(planes.data()), static_cast<std::streamsize>(planes.size()));
+    };
+
+    auto const handle = [&]<typename T>(T const& item)
+    {
+        if constexpr (std::same_as<T, Frame>)
+        {
+            toYuv444(item.pixels, planes);
+            writeFrame();
+        }
+        else if constexpr (std::same_as<T, Repeat>)
+        {
+            for (std::uint64_t i = 0; i < item.count; ++i)
+            {
+                writeFrame();
+            }
+        }
+        else if constexpr (std::same_as<T, Audio>)
+        {
+            for (auto const sample : std::span(item.samples).first(item.size))
+            {
+                writeLittleEndian(audio_, sample);
+            }
+            audioBytes += (item.size * sizeof(std::int16_t));
+        }
+
+        if (!video_ || (audio_.is_open() && !audio_))
+        {
+            throw std::runtime_error("Could not write the recording");
+        }
+    };
+
+    bool stopped = false;
+    while (!stopped)
+    {
+        queue_->waitForItems();
+        while (!stopped && queue_->tryPop(
+                               [&](Message const& message)
+                               {
+                                   stopped = std::holds_alternative<Stop>(message);
+                                   if (stopped || error_)
+                                   {
+                                       return;
+                                   }
+
+                                   try
+                                   {
+                                       std::visit(handle, message);
+                                   }
+                                   catch (...)
+                                   {
+                                       error_ = std::current_exception();
+                                   }
+                               }))
+        {
+        }
+    }
+
+    try
+    {
+        video_.flush();
+        if (audio_.is_open())
+        {
+            writeWavHeader(audio_, options_, static_cast<std::uint32_t>(audioBytes));
+            audio_.flush();
+        }
+    }
+    catch (...)
+    {
+        error_ = (error_ ? error_ : std::current_exception());
+    }
+}
+} // namespace fxb
\ No newline at end of file
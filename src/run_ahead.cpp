@@ -0,0 +1,101 @@
+#include "run_ahead.hpp"
+
+#include <cstdint>
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "game_boy.hpp"
+#include "instance_template.hpp"
+#include "mmu.hpp"
+
+namespace fxb
+{
+namespace
+{
+// Frames run ahead are run again for real later, the host must only see their serial output once
+class SerialMute
+{
+private:
+    Mmu& mmu_;
+    Mmu::OnSerialCallback callback_;
+
+public:
+    explicit SerialMute(Mmu& mmu) noexcept
+        : mmu_(mmu),
+          callback_(mmu.takeOnSerialCallback())
+    {
+    }
+
+    SerialMute(SerialMute const&)            = delete;
+    SerialMute& operator=(SerialMute const&) = delete;
+
+    ~SerialMute() { mmu_.setOnSerialCallback(std::move(callback_)); }
+};
+
+// Snapshots leave cheats out, the shadow picks up any change to them before it runs ahead
+void syncCheats(Mmu const& source, Mmu& target)
+{
+    if (!std::ranges::equal(source.romPatches(), target.romPatches()))
+    {
+        target.setRomPatches({source.romPatches().begin(), source.romPatches().end()});
+    }
+    if (!std::ranges::equal(source.ramPokes(), target.ramPokes()))
+    {
+        target.setRamPokes({source.ramPokes().begin(), source.ramPokes().end()});
+    }
+}
+} // namespace
+
+RunAhead::RunAhead(GameBoy& gameBoy, std::uint32_t frames, Mode mode)
+    : gameBoy_(&gameBoy),
+      frames_(frames),
+      mode_(mode)
+{
+    // The shadow shares the rom and starts with the cheats of the machine, syncing it later only copies the state
+    if ((mode_ == Mode::SecondInstance) && (frames_ > 0))
+    {
+        shadow_ = InstanceTemplate(gameBoy).spawn();
+    }
+}
+
+// Both modes save the machine into the same buffer every frame and restore it once, into the machine itself or into
+// the shadow. restore() instead of load() skips taking a backup, the snapshot was just taken from the same rom
+void RunAhead::runFrame(std::uint8_t buttons, Present const& present)
+{
+    gameBoy_->mmu().setButtons(buttons);
+    gameBoy_->runFrame();
+    if (frames_ == 0)
+    {
+        present(*gameBoy_);
+        return;
+    }
+
+    gameBoy_->save(snapshot_);
+
+    if (mode_ == Mode::SecondInstance)
+    {
+        // The buttons are part of the snapshot, the shadow holds the same ones once synced
+        syncCheats(gameBoy_->mmu(), shadow_->mmu());
+        shadow_->restore(snapshot_);
+        runAhead(*shadow_);
+        present(*shadow_);
+        return;
+    }
+
+    {
+        SerialMute const mute(gameBoy_->mmu());
+        runAhead(*gameBoy_);
+        present(*gameBoy_);
+    }
+    gameBoy_->restore(snapshot_);
+}
+
+void RunAhead::runAhead(GameBoy& gameBoy)
+{
+    for (std::uint32_t frame = 0; frame < frames_; ++frame)
+    {
+        gameBoy.runFrame();
+    }
+}
+} // namespace fxb
\ No newline at end of file
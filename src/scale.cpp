@@ -0,0 +1,236 @@
+#include "scale.hpp"
+
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <format>
+#include <stdexcept>
+
+namespace fxb
+{
+namespace
+{
+using Row = std::array<HostColor, SCREEN_WIDTH>;
+
+void expectOutputSize(std::span<HostColor> output, std::size_t size)
+{
+    if (output.size() != size)
+    {
+        throw std::invalid_argument(std::format("Expected an output of {} pixels, got {}", size, output.size()));
+    }
+}
+
+// Indices are masked the same way resolve() does
+void resolveRow(IndexedFramebuffer const& frame,
+                std::span<HostColor const, PaletteRam::HOST_COLORS> colors,
+                std::size_t y,
+                Row& row) noexcept
+{
+    auto const* indices = &frame.pixels[y * SCREEN_WIDTH];
+    for (std::size_t x = 0; x < SCREEN_WIDTH; ++x)
+    {
+        row[x] = colors[indices[x] & 0x3F];
+    }
+}
+
+// Masks instead of a conditional, with && or ?: in its body a loop keeps its branches and stays scalar. Masks the
+// index the same way resolve() does
+[[nodiscard]] constexpr std::uint8_t pick(bool condition, std::uint8_t lhs, std::uint8_t rhs) noexcept
+{
+    auto const mask = static_cast<std::uint8_t>(-static_cast<int>(condition));
+    return static_cast<std::uint8_t>(((lhs & mask) | (rhs & ~mask)) & 0x3F);
+}
+
+template <std::size_t Factor>
+void upscaleRow(Row const& row, HostColor* output) noexcept
+{
+    for (std::size_t x = 0; x < SCREEN_WIDTH; ++x)
+    {
+        for (std::size_t i = 0; i < Factor; ++i)
+        {
+            output[(x * Factor) + i] = row[x];
+        }
+    }
+}
+} // namespace
+
+void upscaleNearest(IndexedFramebuffer const& frame,
+                    std::span<HostColor const, PaletteRam::HOST_COLORS> colors,
+                    std::size_t factor,
+                    std::span<HostColor> output)
+{
+    if (factor == 0)
+    {
+        throw std::invalid_argument("Scale factor must be at least 1");
+    }
+    expectOutputSize(output, (SCREEN_PIXELS * factor * factor));
+
+    auto const width = (SCREEN_WIDTH * factor);
+
+    Row row;
+    for (std::size_t y = 0; y < SCREEN_HEIGHT; ++y)
+    {
+        resolveRow(frame, colors, y, row);
+
+        // The common factors get an unrolled inner loop, the first output row is then copied for the others
+        auto* const first = &output[(y * factor) * width];
+        switch (factor)
+        {
+            case 1:
+            {
+                upscaleRow<1>(row, first);
+                break;
+            }
+            case 2:
+            {
+                upscaleRow<2>(row, first);
+                break;
+            }
+            case 3:
+            {
+                upscaleRow<3>(row, first);
+                break;
+            }
+            case 4:
+            {
+                upscaleRow<4>(row, first);
+                break;
+            }
+            default:
+            {
+                for (std::size_t x = 0; x < width; ++x)
+                {
+                    first[x] = row[x / factor];
+                }
+                break;
+            }
+        }
+
+        for (std::size_t i = 1; i < factor; ++i)
+        {
+            std::copy_n(first, width, (first + (i * width)));
+        }
+    }
+}
+
+// Around every pixel E the neighbours B (up), D (left), F (right) and H (down) decide each of its four output pixels,
+// pixels past the border repeat the edge
+void smooth2x(IndexedFramebuffer const& frame,
+              std::span<HostColor const, PaletteRam::HOST_COLORS> colors,
+              std::span<HostColor> output)
+{
+    expectOutputSize(output, (4 * SCREEN_PIXELS));
+
+    constexpr auto WIDTH = (2 * SCREEN_WIDTH);
+
+    std::array<std::uint8_t, SCREEN_WIDTH> left;
+    std::array<std::uint8_t, SCREEN_WIDTH> right;
+    std::array<std::array<std::uint8_t, SCREEN_WIDTH>, 4> selected;
+    for (std::size_t y = 0; y < SCREEN_HEIGHT; ++y)
+    {
+        auto const* e = &frame.pixels[y * SCREEN_WIDTH];
+        auto const* b = ((y > 0) ? (e - SCREEN_WIDTH) : e);
+        auto const* h = (((y + 1) < SCREEN_HEIGHT) ? (e + SCREEN_WIDTH) : e);
+
+        left[0] = e[0];
+        std::copy_n(e, (SCREEN_WIDTH - 1), (left.begin() + 1));
+        std::copy_n((e + 1), (SCREEN_WIDTH - 1), right.begin());
+        right[SCREEN_WIDTH - 1] = e[SCREEN_WIDTH - 1];
+
+        // Picks the palette index of each output pixel with byte wide selects and masks, this loop is the vector code
+        for (std::size_t x = 0; x < SCREEN_WIDTH; ++x)
+        {
+            auto const d = left[x];
+            auto const f = right[x];
+
+            // Only an edge when the opposite neighbours differ
+            bool const edge = ((b[x] != h[x]) & (d != f));
+
+            selected[0][x] = pick((edge & (d == b[x])), d, e[x]);
+            selected[1][x] = pick((edge & (b[x] == f)), f, e[x]);
+            selected[2][x] = pick((edge & (d == h[x])), d, e[x]);
+            selected[3][x] = pick((edge & (h[x] == f)), f, e[x]);
+        }
+
+        // Table lookups, a gather per pixel that stays scalar without gather instructions
+        auto* const upper = &output[(2 * y) * WIDTH];
+        auto* const lower = (upper + WIDTH);
+        for (std::size_t x = 0; x < SCREEN_WIDTH; ++x)
+        {
+            upper[2 * x]       = colors[selected[0][x]];
+            upper[(2 * x) + 1] = colors[selected[1][x]];
+            lower[2 * x]       = colors[selected[2][x]];
+            lower[(2 * x) + 1] = colors[selected[3][x]];
+        }
+    }
+}
+
+// Rounds to the nearest value by adding half the block before dividing
+void downsample(IndexedFramebuffer const& frame,
+                std::span<HostColor const, PaletteRam::HOST_COLORS> colors,
+                std::size_t factor,
+                std::span<HostColor> output,
+                Crop const& crop)
+{
+    if ((factor != 2) && (factor != 4))
+    {
+        throw std::invalid_argument(std::format("Downsampling factor must be 2 or 4, got {}", factor));
+    }
+    if (((crop.x + crop.width) > SCREEN_WIDTH) || ((crop.y + crop.height) > SCREEN_HEIGHT) ||
+        ((crop.width % factor) != 0) || ((crop.height % factor) != 0))
+    {
+        throw std::invalid_argument(std::format("Crop {}x{} at {},{} does not fit the screen in blocks of {}",
+                                                crop.width,
+                                                crop.height,
+                                                crop.x,
+                                                crop.y,
+                                                factor));
+    }
+
+    auto const width  = (crop.width / factor);
+    auto const height = (crop.height / factor);
+    expectOutputSize(output, (width * height));
+
+    auto const blockSize = static_cast<std::uint32_t>(factor * factor);
+
+    Row row;
+    std::array<std::uint32_t, SCREEN_WIDTH> red;
+    std::array<std::uint32_t, SCREEN_WIDTH> green;
+    std::array<std::uint32_t, SCREEN_WIDTH> blue;
+    for (std::size_t outY = 0; outY < height; ++outY)
+    {
+        red.fill(0);
+        green.fill(0);
+        blue.fill(0);
+
+        // Columns are summed first so the horizontal pass only touches one row of sums
+        for (std::size_t i = 0; i < factor; ++i)
+        {
+            resolveRow(frame, colors, (crop.y + (outY * factor) + i), row);
+            for (std::size_t x = 0; x < SCREEN_WIDTH; ++x)
+            {
+                red[x] += ((row[x] >> 16) & 0xFF);
+                green[x] += ((row[x] >> 8) & 0xFF);
+                blue[x] += (row[x] & 0xFF);
+            }
+        }
+
+        auto* const line = &output[outY * width];
+        for (std::size_t outX = 0; outX < width; ++outX)
+        {
+            auto const first = (crop.x + (outX * factor));
+
+            std::uint32_t r = (blockSize / 2);
+            std::uint32_t g = (blockSize / 2);
+            std::uint32_t b = (blockSize / 2);
+            for (std::size_t i = 0; i < factor; ++i)
+            {
+                r += red[first + i];
+                g += green[first + i];
+                b += blue[first + i];
+            }
+            line[outX] = (0xFF000000 | ((r / blockSize) << 16) | ((g / blockSize) << 8) | (b / blockSize));
+        }
+    }
+}
+} // namespace fxb
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "shared_frame.hpp"
+
+#include <cerrno>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fxb
+{
+namespace
+{
+[[noreturn]] void throwErrno(std::string const& what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+void* map(std::string const& name, int fd, int protection)
+{
+    auto* address = mmap(nullptr, sizeof(SharedFrameLayout), protection, MAP_SHARED, fd, 0);
+    auto const error  = errno;
+    close(fd);
+
+    if (address == MAP_FAILED)
+    {
+        errno = error;
+        throwErrno("Could not map " + name);
+    }
+    return address;
+}
+} // namespace
+
+SharedFrameWriter::SharedFrameWriter(std::string name)
+    : name_(std::move(name))
+{
+    shm_unlink(name_.c_str());
+
+    auto const fd = shm_open(name_.c_str(), (O_RDWR | O_CREAT | O_EXCL), 0644);
+    if (fd < 0)
+    {
+        throwErrno("Could not create " + name_);
+    }
+
+    if (ftruncate(fd, sizeof(SharedFrameLayout)) != 0)
+    {
+        auto const error = errno;
+        close(fd);
+        shm_unlink(name_.c_str());
+        errno = error;
+        throwErrno("Could not resize " + name_);
+    }
+
+    try
+    {
+        layout_ = new (map(name_, fd, (PROT_READ | PROT_WRITE))) SharedFrameLayout();
+    }
+    catch (...)
+    {
+        shm_unlink(name_.c_str());
+        throw;
+    }
+}
+
+SharedFrameWriter::~SharedFrameWriter()
+{
+    std::destroy_at(layout_);
+    munmap(layout_, sizeof(SharedFrameLayout));
+    shm_unlink(name_.c_str());
+}
+
+HostFramebuffer& SharedFrameWriter::beginFrame() noexcept
+{
+    auto& sequence = layout_->sequences[back_];
+    sequence.store((sequence.load(std::memory_order_relaxed) + 1), std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return layout_->buffers[back_];
+}
+
+void SharedFrameWriter::publish() noexcept
+{
+    auto& sequence = layout_->sequences[back_];
+    sequence.store((sequence.load(std::memory_order_relaxed) + 1), std::memory_order_release);
+    layout_->latest.store(back_, std::memory_order_release);
+    layout_->generation.fetch_add(1, std::memory_order_release);
+
+    // The oldest buffer, two frames have been published since anyone could have picked it up as the latest one
+    back_ = ((back_ + 1) % SharedFrameLayout::BUFFERS);
+}
+
+void SharedFrameWriter::publish(HostFramebuffer const& frame) noexcept
+{
+    beginFrame() = frame;
+    publish();
+}
+
+SharedFrameReader::SharedFrameReader(std::string const& name)
+{
+    auto const fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        throwErrno("Could not open " + name);
+    }
+
+    struct stat status = {};
+    if ((fstat(fd, &status) != 0) || (static_cast<std::size_t>(status.st_size) < sizeof(SharedFrameLayout)))
+    {
+        close(fd);
+        throw std::runtime_error(name + " is not a frame buffer");
+    }
+
+    layout_ = static_cast<SharedFrameLayout const*>(map(name, fd, PROT_READ));
+    if ((layout_->magic != SharedFrameLayout::MAGIC) || (layout_->version != SharedFrameLayout::VERSION))
+    {
+        munmap(const_cast<SharedFrameLayout*>(layout_), sizeof(SharedFrameLayout));
+        throw std::runtime_error(name + " is not a frame buffer of this version");
+    }
+}
+
+SharedFrameReader::~SharedFrameReader()
+{
+    munmap(const_cast<SharedFrameLayout*>(layout_), sizeof(SharedFrameLayout));
+}
+} // namespace fxb
\ No newline at end of file
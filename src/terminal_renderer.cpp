@@ -0,0 +1,124 @@
+#include "terminal_renderer.hpp"
+
+#include <cstdint>
+#include <array>
+#include <format>
+#include <iterator>
+#include <string>
+
+namespace fxb
+{
+namespace
+{
+constexpr std::array<std::int32_t, 6> CUBE_LEVELS = {0x00, 0x5F, 0x87, 0xAF, 0xD7, 0xFF};
+
+constexpr std::int32_t cubeIndex(std::int32_t value) noexcept
+{
+    if (value < 48)
+    {
+        return 0;
+    }
+    if (value < 115)
+    {
+        return 1;
+    }
+    return ((value - 35) / 40);
+}
+
+constexpr std::int32_t distance(std::array<std::int32_t, 3> lhs, std::array<std::int32_t, 3> rhs) noexcept
+{
+    std::int32_t sum = 0;
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+    {
+        sum += ((lhs[i] - rhs[i]) * (lhs[i] - rhs[i]));
+    }
+    return sum;
+}
+
+// Marks a cell that has to be drawn no matter what it held before, no pair of colors produces it
+constexpr std::uint32_t INVALID_CELL = 0x10000;
+} // namespace
+
+std::uint8_t toXterm256(HostColor color) noexcept
+{
+    auto const r = static_cast<std::int32_t>((color >> 16) & 0xFF);
+    auto const g = static_cast<std::int32_t>((color >> 8) & 0xFF);
+    auto const b = static_cast<std::int32_t>(color & 0xFF);
+
+    auto const qr = cubeIndex(r);
+    auto const qg = cubeIndex(g);
+    auto const qb = cubeIndex(b);
+
+    // Gray ramp entries run from 0x08 to 0xEE in steps of 10
+    auto const average   = ((r + g + b) / 3);
+    auto const grayIndex = ((average > 238) ? 23 : ((average < 8) ? 0 : ((average - 3) / 10)));
+    auto const gray      = (8 + (10 * grayIndex));
+
+    auto const cubeDistance = distance({r, g, b}, {CUBE_LEVELS[qr], CUBE_LEVELS[qg], CUBE_LEVELS[qb]});
+    auto const grayDistance = distance({r, g, b}, {gray, gray, gray});
+    if (grayDistance < cubeDistance)
+    {
+        return static_cast<std::uint8_t>(232 + grayIndex);
+    }
+    return static_cast<std::uint8_t>(16 + (36 * qr) + (6 * qg) + qb);
+}
+
+bool TerminalRenderer::render(HostFramebuffer const& frame, std::string& output, Clock::time_point now)
+{
+    if (drawn_ && ((now - lastDraw_) < interval_))
+    {
+        return false;
+    }
+    lastDraw_ = now;
+
+    if (!drawn_)
+    {
+        output += "\x1b[2J";
+        cells_.fill(INVALID_CELL);
+        drawn_ = true;
+    }
+
+    // Cursor and colors are tracked so runs of changed cells need neither moves nor color changes
+    std::size_t cursor         = cells_.size();
+    std::uint32_t currentColor = INVALID_CELL;
+
+    auto out = std::back_inserter(output);
+    for (std::size_t row = 0; row < ROWS; ++row)
+    {
+        auto const* upper = &frame[(2 * row) * SCREEN_WIDTH];
+        auto const* lower = (upper + SCREEN_WIDTH);
+
+        for (std::size_t column = 0; column < COLUMNS; ++column)
+        {
+            auto const index = ((row * COLUMNS) + column);
+            auto const cell  = static_cast<std::uint32_t>((toXterm256(upper[column]) << 8) | toXterm256(lower[column]));
+            if (cells_[index] == cell)
+            {
+                continue;
+            }
+            cells_[index] = cell;
+
+            if (cursor != index)
+            {
+                std::format_to(out, "\x1b[{};{}H", (row + 1), (column + 1));
+            }
+            if (currentColor != cell)
+            {
+                std::format_to(out, "\x1b[38;5;{};48;5;{}m", (cell >> 8), (cell & 0xFF));
+                currentColor = cell;
+            }
+            // U+2580 upper half block
+            output += "\xE2\x96\x80";
+
+            // The cursor stays put after the last column until the next character arrives
+            cursor = (((column + 1) < COLUMNS) ? (index + 1) : cells_.size());
+        }
+    }
+
+    if (currentColor != INVALID_CELL)
+    {
+        output += "\x1b[0m";
+    }
+    return true;
+}
+} // namespace fxb
\ No newline at end of file
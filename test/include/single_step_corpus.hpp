@@ -0,0 +1,148 @@
+#ifndef FAUXBOY_TEST_SINGLE_STEP_CORPUS_HPP
+#define FAUXBOY_TEST_SINGLE_STEP_CORPUS_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <bit>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <simdjson.h>
+
+#include <fauxboy/cpu.hpp>
+
+// Binary form of the SingleStepTests json files, one file per opcode made of a header followed by fixed size records
+// so a whole file can be mapped and walked without parsing or allocating anything per test
+namespace Corpus
+{
+static_assert(std::endian::native == std::endian::little, "The corpus is stored in little endian host layout");
+
+inline constexpr std::array<char, 8> MAGIC = {'F', 'X', 'B', 'S', 'S', 'T', '\0', '\0'};
+inline constexpr std::uint32_t VERSION     = 1;
+
+inline constexpr std::size_t MAX_NAME_LENGTH = 16;
+inline constexpr std::size_t MAX_RAM_SLOTS   = 16;
+inline constexpr std::size_t MAX_CYCLES      = 8;
+
+enum class CycleMode : std::uint8_t
+{
+    INTERNAL = 0, // "---"
+    READ     = 1, // "r-m"
+    WRITE    = 2  // "-wm"
+};
+
+struct Registers
+{
+    std::uint8_t A   = 0;
+    std::uint8_t B   = 0;
+    std::uint8_t C   = 0;
+    std::uint8_t D   = 0;
+    std::uint8_t E   = 0;
+    std::uint8_t F   = 0;
+    std::uint8_t H   = 0;
+    std::uint8_t L   = 0;
+    std::uint16_t SP = 0;
+    std::uint16_t PC = 0;
+
+    [[nodiscard]] fxb::CpuState toCpuState() const noexcept
+    {
+        return {.A = A, .B = B, .C = C, .D = D, .E = E, .F = F, .H = H, .L = L, .SP = SP, .PC = PC};
+    }
+};
+
+struct RamSlot
+{
+    std::uint16_t address = 0;
+    std::uint8_t value    = 0;
+    std::uint8_t reserved = 0;
+};
+
+struct State
+{
+    Registers registers;
+    std::uint8_t ramCount                  = 0;
+    std::array<std::uint8_t, 3> reserved   = {};
+    std::array<RamSlot, MAX_RAM_SLOTS> ram = {};
+
+    [[nodiscard]] std::span<RamSlot const> slots() const noexcept { return std::span(ram).first(ramCount); }
+};
+
+struct Cycle
+{
+    std::uint16_t address = 0;
+    std::uint8_t data     = 0;
+    CycleMode mode        = CycleMode::INTERNAL;
+};
+
+struct Record
+{
+    std::array<char, MAX_NAME_LENGTH> name = {};
+    State initial;
+    State final;
+    std::uint8_t cycleCount              = 0;
+    std::array<std::uint8_t, 3> reserved = {};
+    std::array<Cycle, MAX_CYCLES> cycles = {};
+
+    [[nodiscard]] std::string_view testName() const noexcept
+    {
+        return {name.data(), std::char_traits<char>::length(name.data())};
+    }
+
+    [[nodiscard]] std::span<Cycle const> cycleLog() const noexcept { return std::span(cycles).first(cycleCount); }
+};
+
+struct Header
+{
+    std::array<char, 8> magic             = MAGIC;
+    std::uint32_t version                 = VERSION;
+    std::uint32_t recordSize              = sizeof(Record);
+    std::uint32_t recordCount             = 0;
+    std::uint16_t opcode                  = 0;
+    std::array<std::uint8_t, 10> reserved = {};
+};
+
+static_assert(std::is_trivially_copyable_v<Header> && (sizeof(Header) == 32));
+static_assert(std::is_trivially_copyable_v<Record> && (sizeof(Record) == 212));
+
+// Parses one test object of a json file into a record, throws when it does not fit the fixed layout
+void parseRecord(simdjson::ondemand::object json, Record& record);
+
+// Loads a json file into buffer and starts iterating it with parser, buffer has to outlive the document
+simdjson::ondemand::document loadJson(std::filesystem::path const& path,
+                                      simdjson::ondemand::parser& parser,
+                                      std::string& buffer);
+
+void writeCorpus(std::filesystem::path const& path, std::uint16_t opcode, std::span<Record const> records);
+
+// Read only mapping of a corpus file
+class CorpusFile
+{
+private:
+    void const* mapping_ = nullptr;
+    std::size_t size_    = 0;
+    Header header_;
+    std::span<Record const> records_;
+
+public:
+    explicit CorpusFile(std::filesystem::path const& path);
+
+    CorpusFile(CorpusFile const&)            = delete;
+    CorpusFile& operator=(CorpusFile const&) = delete;
+
+    ~CorpusFile();
+
+    [[nodiscard]] std::uint16_t opcode() const noexcept { return header_.opcode; }
+    [[nodiscard]] std::span<Record const> records() const noexcept { return records_; }
+};
+
+// "00.json" holds opcode 0x00 and "cb 00.json" holds 0xCB00, the same naming is used for the corpus files
+[[nodiscard]] std::string filenameFromOpcode(std::uint16_t opcode, std::string_view extension);
+[[nodiscard]] std::uint16_t opcodeFromFilename(std::filesystem::path const& path);
+} // namespace Corpus
+
+#endif // FAUXBOY_TEST_SINGLE_STEP_CORPUS_HPP
\ No newline at end of file
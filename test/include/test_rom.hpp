@@ -0,0 +1,34 @@
+#ifndef FAUXBOY_TEST_TEST_ROM_HPP
+#define FAUXBOY_TEST_TEST_ROM_HPP
+
+#include <cstdint>
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include <fauxboy/cartridge.hpp>
+
+// Tiny programs for tests that need a whole machine running something
+namespace TestRom
+{
+// JR -2, spins at the entry point
+inline constexpr std::uint8_t SPIN[] = {0x18, 0xFE};
+
+// LD HL,0xC000; loop: INC (HL); INC L; JR loop. Work ram changes on every frame
+inline constexpr std::uint8_t COUNTER[] = {0x21, 0x00, 0xC0, 0x34, 0x2C, 0x18, 0xFC};
+
+// Adds the action buttons into work ram in a loop so the state depends on the input. LD HL,0xC000; loop: LD A,0x10;
+// LDH (0x00),A; LDH A,(0x00); ADD (HL); LD (HL+),A; RES 5,H; JR loop
+inline constexpr std::uint8_t BUTTON_COUNTER[] = {
+    0x21, 0x00, 0xC0, 0x3E, 0x10, 0xE0, 0x00, 0xF0, 0x00, 0x86, 0x22, 0xCB, 0xAC, 0x18, 0xF4};
+
+// Two banks without an MBC, the program sits at the entry point and everything else is NOP
+[[nodiscard]] inline std::vector<std::uint8_t> build(std::span<std::uint8_t const> program)
+{
+    std::vector<std::uint8_t> rom((2 * fxb::Cartridge::ROM_BANK_SIZE), 0x00);
+    std::ranges::copy(program, (rom.begin() + 0x0100));
+    return rom;
+}
+} // namespace TestRom
+
+#endif // FAUXBOY_TEST_TEST_ROM_HPP
\ No newline at end of file
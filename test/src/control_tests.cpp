@@ -0,0 +1,116 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <fauxboy/cartridge.hpp>
+#include <fauxboy/control.hpp>
+#include <fauxboy/game_boy.hpp>
+
+#include "test_rom.hpp"
+
+using namespace fxb;
+
+namespace
+{
+struct Reply
+{
+    ControlStatus status;
+    std::vector<std::uint8_t> data;
+};
+
+void appendCommand(std::vector<std::uint8_t>& batch, ControlCommand command, std::vector<std::uint8_t> const& payload)
+{
+    batch.push_back(static_cast<std::uint8_t>(command));
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        batch.push_back(static_cast<std::uint8_t>(payload.size() >> (8 * i)));
+    }
+    batch.insert(batch.end(), payload.begin(), payload.end());
+}
+
+std::vector<Reply> run(ControlSession& session, std::vector<std::uint8_t> const& batch)
+{
+    std::vector<std::uint8_t> bytes;
+    session.handle(batch, bytes);
+
+    std::vector<Reply> replies;
+    auto remaining = std::span<std::uint8_t const>(bytes);
+    while (!remaining.empty())
+    {
+        REQUIRE(remaining.size() >= ControlSession::COMMAND_HEADER_SIZE);
+        auto const length = (remaining[1] | (remaining[2] << 8) | (remaining[3] << 16) | (remaining[4] << 24));
+        auto const data   = remaining.subspan(ControlSession::COMMAND_HEADER_SIZE, length);
+        replies.push_back({static_cast<ControlStatus>(remaining[0]), {data.begin(), data.end()}});
+        remaining = remaining.subspan(ControlSession::COMMAND_HEADER_SIZE + length);
+    }
+    return replies;
+}
+
+} // namespace
+
+TEST_CASE("A batch runs every command and restores saved states", "[control]")
+{
+    ControlSession session;
+
+    std::vector<std::uint8_t> batch;
+    appendCommand(batch, ControlCommand::LOAD, TestRom::build(TestRom::SPIN));
+    appendCommand(batch, ControlCommand::STEP_FRAMES, {2, 0, 0, 0});
+    appendCommand(batch, ControlCommand::SAVE_STATE, {});
+
+    auto const first = run(session, batch);
+    REQUIRE(first.size() == 3);
+    REQUIRE(first[1].status == ControlStatus::OK);
+    REQUIRE(first[1].data.size() == sizeof(std::uint64_t));
+    REQUIRE(first[2].status == ControlStatus::OK);
+    auto const snapshot = first[2].data;
+
+    batch.clear();
+    appendCommand(batch, ControlCommand::STEP_FRAMES, {3, 0, 0, 0});
+    appendCommand(batch, ControlCommand::LOAD_STATE, snapshot);
+    appendCommand(batch, ControlCommand::SAVE_STATE, {});
+    appendCommand(batch, ControlCommand::READ_MEMORY, {0x00, 0x01, 2, 0, 0, 0});
+
+    auto const second = run(session, batch);
+    REQUIRE(second.size() == 4);
+    REQUIRE(second[0].data != first[1].data);
+    REQUIRE(second[2].data == snapshot);
+    REQUIRE(second[3].data == std::vector<std::uint8_t>{0x18, 0xFE});
+}
+
+TEST_CASE("A batch stops at the first failing command", "[control]")
+{
+    ControlSession session;
+
+    std::vector<std::uint8_t> batch;
+    appendCommand(batch, ControlCommand::SET_BUTTONS, {Mmu::BUTTON_A});
+    appendCommand(batch, ControlCommand::LOAD, TestRom::build(TestRom::SPIN));
+
+    auto replies = run(session, batch);
+    REQUIRE(replies.size() == 1);
+    REQUIRE(replies[0].status == ControlStatus::ERROR);
+
+    batch.clear();
+    appendCommand(batch, ControlCommand::LOAD, TestRom::build(TestRom::SPIN));
+    appendCommand(batch, ControlCommand::READ_MEMORY, {0xFF, 0xFF, 2, 0, 0, 0});
+    appendCommand(batch, ControlCommand::SAVE_STATE, {});
+
+    replies = run(session, batch);
+    REQUIRE(replies.size() == 2);
+    REQUIRE(replies[0].status == ControlStatus::OK);
+    REQUIRE(replies[1].status == ControlStatus::ERROR);
+}
+
+TEST_CASE("Loading a foreign snapshot leaves the machine as it was", "[control]")
+{
+    GameBoy gameBoy{Cartridge(TestRom::build(TestRom::SPIN))};
+    gameBoy.runFrame();
+    auto const before = gameBoy.save();
+
+    auto truncated = before;
+    truncated.resize(truncated.size() / 2);
+    REQUIRE_THROWS_AS(gameBoy.load(truncated), BadSnapshotException);
+    REQUIRE(gameBoy.save() == before);
+}
\ No newline at end of file
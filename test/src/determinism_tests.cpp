@@ -0,0 +1,214 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+#include <span>
+#include <string>
+#include <thread>
+#include <optional>
+#include <format>
+#include <utility>
+
+#include <fauxboy/cartridge.hpp>
+#include <fauxboy/cpu.hpp>
+#include <fauxboy/flat_bus.hpp>
+#include <fauxboy/game_boy.hpp>
+#include <fauxboy/hash.hpp>
+
+#include "test_rom.hpp"
+
+using namespace fxb;
+
+namespace
+{
+constexpr int CHECKPOINT_COUNT     = 64;
+constexpr int STEPS_PER_CHECKPOINT = 1024;
+
+struct Run
+{
+    std::vector<std::uint64_t> checkpoints;
+    int illegalOpcodeCount = 0;
+};
+
+// Deterministic pseudo random memory image so every run starts from the exact same machine
+void fillMemory(std::span<std::uint8_t> memory, std::uint64_t seed)
+{
+    for (auto& byte : memory)
+    {
+        seed ^= (seed << 13);
+        seed ^= (seed >> 7);
+        seed ^= (seed << 17);
+        byte = getLower(seed);
+    }
+}
+
+Run runProgram(std::uint64_t seed)
+{
+    Run run;
+
+    FlatBus bus;
+    fillMemory(bus.memory(), seed);
+
+    Cpu cpu(&bus);
+    cpu.reset({.SP = 0xFFFE, .PC = 0x0100});
+
+    for (int checkpoint = 0; checkpoint < CHECKPOINT_COUNT; ++checkpoint)
+    {
+        for (int i = 0; i < STEPS_PER_CHECKPOINT; ++i)
+        {
+            // Random code regularly lands on illegal opcodes, the opcode has already been fetched so keep going
+            try
+            {
+                cpu.step();
+            }
+            catch (IllegalOpcodeException const&)
+            {
+                ++run.illegalOpcodeCount;
+            }
+        }
+        run.checkpoints.push_back(hashState(cpu.state(), bus.memory()));
+    }
+
+    return run;
+}
+
+std::optional<std::size_t> findFirstDivergence(Run const& lhs, Run const& rhs)
+{
+    auto const count = std::min(lhs.checkpoints.size(), rhs.checkpoints.size());
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (lhs.checkpoints[i] != rhs.checkpoints[i])
+        {
+            return i;
+        }
+    }
+
+    if (lhs.checkpoints.size() != rhs.checkpoints.size())
+    {
+        return count;
+    }
+
+    return std::nullopt;
+}
+} // namespace
+
+TEST_CASE("hashBytes matches the XXH64 reference", "[hash]")
+{
+    auto const hash = [](std::string const& text)
+    {
+        return hashBytes({reinterpret_cast<std::uint8_t const*>(text.data()), text.size()});
+    };
+
+    REQUIRE(hash("") == 0xEF46DB3751D8E999ull);
+    REQUIRE(hash("a") == 0xD24EC4F1A98C6E5Bull);
+    REQUIRE(hash("abc") == 0x44BC2CF5AD770999ull);
+
+    // One full stripe, a stripe with every tail, and several stripes
+    REQUIRE(hash("0123456789abcdefghijklmnopqrstuv") == 0xBF7C9DBE16B5C6E2ull);
+    REQUIRE(hash("The quick brown fox jumps over the lazy dog") == 0x0B242D361FDA71BCull);
+    REQUIRE(hash("The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog.")
+            == 0x5282B0966CCDB49Dull);
+}
+
+TEST_CASE("hashBytes seeds every lane", "[hash]")
+{
+    constexpr std::uint64_t SEED = 0x9E3779B97F4A7C15ull;
+
+    std::string const text = "The quick brown fox jumps over the lazy dog";
+    std::span const bytes(reinterpret_cast<std::uint8_t const*>(text.data()), text.size());
+
+    REQUIRE(hashBytes(bytes, SEED) == 0x7CFAC66832F66B74ull);
+    REQUIRE(hashBytes(bytes.first(32), SEED) == 0x0DF819D29EB49A58ull);
+}
+
+TEST_CASE("HashStream matches hashBytes however the input is split", "[hash]")
+{
+    std::vector<std::uint8_t> bytes(200);
+    fillMemory(bytes, 0x0123'4567'89AB'CDEFull);
+
+    auto const pieceSize = GENERATE(1u, 3u, 8u, 31u, 32u, 33u, 100u, 200u);
+    auto const length    = GENERATE(0u, 5u, 32u, 63u, 200u);
+    auto const input     = std::span<std::uint8_t const>(bytes).first(length);
+
+    HashStream stream(7);
+    for (std::size_t offset = 0; offset < input.size(); offset += pieceSize)
+    {
+        stream.update(input.subspan(offset, std::min<std::size_t>(pieceSize, (input.size() - offset))));
+    }
+
+    INFO("pieces of " << pieceSize << " over " << length << " bytes");
+    REQUIRE(stream.digest() == hashBytes(input, 7));
+}
+
+TEST_CASE("hashState covers every register", "[hash]")
+{
+    CpuState const state = {.A = 1, .B = 2, .C = 3, .D = 4, .E = 5, .F = 0x50, .H = 6, .L = 7, .SP = 8, .PC = 9};
+
+    auto other = state;
+    other.PC   = 0x0900;
+
+    REQUIRE(hashState(state) == hashState(state));
+    REQUIRE(hashState(state) != hashState(other));
+}
+
+TEST_CASE("Execution is deterministic across threads", "[determinism]")
+{
+    auto const seed = GENERATE(0x1234'5678'9ABC'DEF0ull, 0x0F0F'0F0F'F0F0'F0F0ull, 0xDEAD'BEEF'CAFE'BABEull);
+
+    Run lhs;
+    Run rhs;
+    {
+        auto lhsThread = std::jthread([&lhs, seed] { lhs = runProgram(seed); });
+        auto rhsThread = std::jthread([&rhs, seed] { rhs = runProgram(seed); });
+    }
+
+    auto const divergence = findFirstDivergence(lhs, rhs);
+
+    INFO("seed: " << std::format("0x{:016X}", seed));
+    INFO("first diverging checkpoint: " << (divergence ? std::to_string(*divergence) : "none")
+                                        << " (every " << STEPS_PER_CHECKPOINT << " steps)");
+    REQUIRE_FALSE(divergence.has_value());
+    REQUIRE(lhs.illegalOpcodeCount == rhs.illegalOpcodeCount);
+}
+
+TEST_CASE("Whole machine hashes agree across threads at every frame", "[determinism]")
+{
+    auto const rom = TestRom::build(TestRom::COUNTER);
+
+    auto const run = [&rom]
+    {
+        GameBoy gameBoy{Cartridge(rom)};
+        std::vector<std::uint64_t> hashes;
+        for (int frame = 0; frame < 8; ++frame)
+        {
+            gameBoy.runFrame();
+            hashes.push_back(gameBoy.hash());
+        }
+        return hashes;
+    };
+
+    std::vector<std::uint64_t> lhs;
+    std::vector<std::uint64_t> rhs;
+    {
+        auto lhsThread = std::jthread([&] { lhs = run(); });
+        auto rhsThread = std::jthread([&] { rhs = run(); });
+    }
+
+    auto const divergence = std::ranges::mismatch(lhs, rhs).in1;
+    INFO("first diverging frame: " << ((divergence == lhs.end()) ? 0 : ((divergence - lhs.begin()) + 1)));
+    REQUIRE(divergence == lhs.end());
+
+    // The machine keeps changing, so equal hashes are not just the same constant
+    REQUIRE(lhs.front() != lhs.back());
+
+    // Streamed straight from the state, yet the same as hashing a snapshot, which a reused buffer reproduces
+    GameBoy gameBoy{Cartridge(rom)};
+    gameBoy.runFrame();
+    std::vector<std::uint8_t> buffer = {0xAA};
+    gameBoy.save(buffer);
+    REQUIRE(buffer == gameBoy.save());
+    REQUIRE(gameBoy.hash() == hashBytes(buffer));
+    REQUIRE(gameBoy.hash() == lhs.front());
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <cstdint>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include <fauxboy/frame_pacer.hpp>
+
+using namespace fxb;
+using namespace std::chrono_literals;
+
+namespace
+{
+// Time only moves when the pacer reads it, sleeps or the test does work, so every run sees the same schedule
+struct FakeClock
+{
+    FramePacer::Clock::time_point now = {};
+    // How far every read moves the clock, what a spinning loop iteration costs
+    FramePacer::Clock::duration readCost = 1us;
+    // How far a sleep overshoots its deadline
+    FramePacer::Clock::duration oversleep = 0ns;
+
+    [[nodiscard]] FramePacer::Timer timer()
+    {
+        auto read  = [this] { return (now += readCost); };
+        auto sleep = [this](FramePacer::Clock::time_point deadline) { now = (std::max(now, deadline) + oversleep); };
+        return {.now = read, .sleepUntil = sleep};
+    }
+};
+
+constexpr auto PERIOD = std::chrono::duration<double>(1.0 / FramePacer::FRAME_RATE);
+} // namespace
+
+TEST_CASE("The pacer holds the frame rate at the chosen speed", "[frame_pacer]")
+{
+    constexpr std::uint64_t FRAMES = 600;
+
+    auto const speed = GENERATE(0.5, 1.0, 4.0);
+
+    FakeClock clock;
+    clock.oversleep = 300us;
+    FramePacer pacer(1ms, clock.timer());
+    pacer.setSpeed(speed);
+
+    auto const start = clock.now;
+    for (std::uint64_t i = 0; i < FRAMES; ++i)
+    {
+        REQUIRE(pacer.shouldRender());
+        pacer.wait();
+    }
+    auto const elapsed = std::chrono::duration<double>(clock.now - start);
+
+    // The deadlines advance by whole periods, so the rate holds exactly up to the wakeup of the last frame
+    auto const expected = ((PERIOD * static_cast<double>(FRAMES)) / speed);
+    REQUIRE(elapsed >= (expected - 1us));
+    REQUIRE(elapsed <= (expected + 10us));
+
+    auto const& statistics = pacer.statistics();
+    REQUIRE(statistics.frames == FRAMES);
+    REQUIRE(statistics.skippedFrames == 0);
+    REQUIRE(statistics.lateFrames == 0);
+    REQUIRE(statistics.resyncs == 0);
+
+    // Spinning absorbs the oversleep, what is left is the cost of one read of the clock
+    REQUIRE(statistics.maxJitter <= 1us);
+
+    REQUIRE_THROWS_AS(pacer.setSpeed(0.0), std::invalid_argument);
+}
+
+TEST_CASE("A host that stalls now and then skips rendering and catches up", "[frame_pacer]")
+{
+    constexpr std::uint64_t FRAMES = 300;
+
+    FakeClock clock;
+    FramePacer pacer(1ms, clock.timer());
+
+    // Every tenth frame takes three frames worth of time, the frames after it run late until the schedule is met again
+    auto const stall = std::chrono::duration_cast<FramePacer::Clock::duration>(PERIOD * 3.0);
+
+    auto const start       = clock.now;
+    std::uint64_t rendered = 0;
+    for (std::uint64_t i = 0; i < FRAMES; ++i)
+    {
+        clock.now += (((i % 10) == 0) ? stall : FramePacer::Clock::duration());
+        rendered += (pacer.shouldRender() ? 1 : 0);
+        pacer.wait();
+    }
+    auto const elapsed = std::chrono::duration<double>(clock.now - start);
+
+    // Late frames keep their slots, so the whole run still takes as long as the frames it showed
+    auto const expected = (PERIOD * static_cast<double>(FRAMES));
+    REQUIRE(elapsed >= (expected - 1us));
+    REQUIRE(elapsed <= (expected + 10us));
+
+    // Each stall costs the frame it happened in and the ones needed to catch up
+    auto const& statistics = pacer.statistics();
+    REQUIRE((rendered + statistics.skippedFrames) == FRAMES);
+    REQUIRE(statistics.skippedFrames >= (FRAMES / 10));
+    REQUIRE(statistics.skippedFrames <= (3 * (FRAMES / 10)));
+    REQUIRE(statistics.lateFrames >= (FRAMES / 10));
+    REQUIRE(statistics.lateFrames <= (3 * (FRAMES / 10)));
+    REQUIRE(statistics.resyncs == 0);
+    REQUIRE(statistics.maxJitter <= 1us);
+}
+
+TEST_CASE("A host that falls behind skips rendering and resyncs", "[frame_pacer]")
+{
+    FakeClock clock;
+    FramePacer pacer(1ms, clock.timer());
+    pacer.setSpeed(10.0);
+
+    clock.now += 30ms;
+    for (std::uint32_t i = 0; i < FramePacer::MAX_SKIPPED_FRAMES; ++i)
+    {
+        REQUIRE_FALSE(pacer.shouldRender());
+    }
+    REQUIRE(pacer.shouldRender());
+
+    // Arriving after the deadline is lag, not jitter
+    pacer.wait();
+    REQUIRE(pacer.statistics().resyncs == 1);
+    REQUIRE(pacer.statistics().lateFrames == 1);
+    REQUIRE(pacer.statistics().skippedFrames == FramePacer::MAX_SKIPPED_FRAMES);
+    REQUIRE(pacer.statistics().maxJitter == 0ns);
+    REQUIRE(pacer.statistics().meanJitter() == 0ns);
+
+    // Back on schedule the next frame is drawn and waited for
+    REQUIRE(pacer.shouldRender());
+    pacer.wait();
+    REQUIRE(pacer.statistics().lateFrames == 1);
+    REQUIRE(pacer.statistics().frames == 2);
+}
+
+TEST_CASE("The system timer paces in real time", "[frame_pacer]")
+{
+    constexpr std::uint64_t FRAMES = 10;
+
+    FramePacer pacer;
+    pacer.setSpeed(10.0);
+
+    // Deadlines only move later, however loaded the host the frames can not finish early
+    auto const start = FramePacer::Clock::now();
+    for (std::uint64_t i = 0; i < FRAMES; ++i)
+    {
+        pacer.wait();
+    }
+    REQUIRE((FramePacer::Clock::now() - start) >= ((PERIOD * static_cast<double>(FRAMES - 1)) / 10.0));
+    REQUIRE(pacer.statistics().frames == FRAMES);
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <fauxboy/address.hpp>
+#include <fauxboy/cartridge.hpp>
+#include <fauxboy/cheats.hpp>
+#include <fauxboy/game_boy.hpp>
+#include <fauxboy/instance_template.hpp>
+
+#include "test_rom.hpp"
+
+using namespace fxb;
+
+TEST_CASE("Instances spawned from a template continue like the source", "[instance_template]")
+{
+    GameBoy source{Cartridge(TestRom::build(TestRom::COUNTER))};
+    source.runFrame();
+    InstanceTemplate const instanceTemplate(source);
+
+    auto first  = instanceTemplate.spawn();
+    auto second = instanceTemplate.spawn();
+    REQUIRE(first->save() == source.save());
+
+    // The rom is shared rather than copied
+    REQUIRE(first->mmu().cartridge().lowerRomBank().data() == source.mmu().cartridge().lowerRomBank().data());
+
+    for (int i = 0; i < 3; ++i)
+    {
+        source.runFrame();
+        first->runFrame();
+        second->runFrame();
+    }
+    REQUIRE(first->save() == source.save());
+    REQUIRE(second->save() == source.save());
+}
+
+TEST_CASE("Instances keep the cheats of the source", "[instance_template]")
+{
+    // INC L becomes INC (HL) and 0xC080 is held at 0x42, both change what ends up in work ram
+    auto const setCheats = [](GameBoy& gameBoy)
+    {
+        gameBoy.mmu().setRomPatches({{.address = 0x0104, .value = 0x34, .compare = 0x2C}});
+        gameBoy.mmu().setRamPokes({parseGameShark("014280C0")});
+    };
+
+    GameBoy source{Cartridge(TestRom::build(TestRom::COUNTER))};
+    GameBoy plain{Cartridge(TestRom::build(TestRom::COUNTER))};
+    setCheats(source);
+    source.runFrame();
+    plain.runFrame();
+
+    InstanceTemplate const instanceTemplate(source);
+    auto instance = instanceTemplate.spawn();
+    REQUIRE(instance->mmu().romPatches().size() == 1);
+    REQUIRE(instance->mmu().ramPokes().size() == 1);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        source.runFrame();
+        instance->runFrame();
+        plain.runFrame();
+    }
+    REQUIRE(instance->save() == source.save());
+    REQUIRE(instance->save() != plain.save());
+    REQUIRE(instance->mmu().read(Address(0xC080)) == 0x42);
+}
\ No newline at end of file
@@ -0,0 +1,248 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fauxboy/address.hpp>
+#include <fauxboy/cartridge.hpp>
+#include <fauxboy/cheats.hpp>
+#include <fauxboy/game_boy.hpp>
+#include <fauxboy/mmu.hpp>
+
+using namespace fxb;
+
+namespace
+{
+// Every byte of a bank holds the bank number
+Cartridge makeCartridge(std::uint8_t type, std::size_t banks, std::uint8_t ramSize = 0x00, bool cgb = false)
+{
+    std::vector<std::uint8_t> rom(banks * Cartridge::ROM_BANK_SIZE);
+    for (std::size_t i = 0; i < rom.size(); ++i)
+    {
+        rom[i] = static_cast<std::uint8_t>(i / Cartridge::ROM_BANK_SIZE);
+    }
+    rom[0x0147] = type;
+    rom[0x0148] = 0x00;
+    rom[0x0149] = ramSize;
+    rom[0x0143] = (cgb ? 0x80 : 0x00);
+    return Cartridge(std::move(rom));
+}
+} // namespace
+
+TEST_CASE("Echo ram mirrors work ram", "[mmu]")
+{
+    Mmu mmu(makeCartridge(0x00, 2));
+
+    mmu.write(Address(0xC123), 0xAB);
+    REQUIRE(mmu.read(Address(0xE123)) == 0xAB);
+
+    mmu.write(Address(0xFDFF), 0xCD);
+    REQUIRE(mmu.read(Address(0xDDFF)) == 0xCD);
+}
+
+TEST_CASE("Rom writes switch MBC1 banks instead of changing the rom", "[mmu]")
+{
+    Mmu mmu(makeCartridge(0x01, 8));
+
+    REQUIRE(mmu.read(Address(0x4000)) == 1);
+
+    mmu.write(Address(0x2000), 0x05);
+    REQUIRE(mmu.read(Address(0x4000)) == 5);
+    REQUIRE(mmu.read(Address(0x2000)) == 0);
+
+    // Bank 0 can not be selected in the upper half
+    mmu.write(Address(0x2000), 0x00);
+    REQUIRE(mmu.read(Address(0x7FFF)) == 1);
+}
+
+TEST_CASE("Cartridge ram is only mapped while enabled", "[mmu]")
+{
+    Mmu mmu(makeCartridge(0x03, 2, 0x02));
+
+    mmu.write(Address(0xA000), 0x12);
+    REQUIRE(mmu.read(Address(0xA000)) == 0xFF);
+
+    mmu.write(Address(0x0000), 0x0A);
+    mmu.write(Address(0xA000), 0x12);
+    REQUIRE(mmu.read(Address(0xA000)) == 0x12);
+}
+
+TEST_CASE("Serial transfers complete immediately", "[mmu]")
+{
+    Mmu mmu(makeCartridge(0x00, 2));
+
+    std::string output;
+    mmu.setOnSerialCallback([&output](std::uint8_t value) { output += static_cast<char>(value); });
+
+    mmu.write(Address(0xFF01), 'O');
+    mmu.write(Address(0xFF02), 0x81);
+    mmu.write(Address(0xFF01), 'K');
+    mmu.write(Address(0xFF02), 0x81);
+
+    REQUIRE(output == "OK");
+    REQUIRE((mmu.read(Address(0xFF02)) & 0x80) == 0);
+    REQUIRE((mmu.interruptFlags() & Mmu::INTERRUPT_SERIAL) != 0);
+}
+
+TEST_CASE("Joypad groups are selected through JOYP", "[mmu]")
+{
+    Mmu mmu(makeCartridge(0x00, 2));
+
+    mmu.setButtons(Mmu::BUTTON_START | Mmu::BUTTON_LEFT);
+    REQUIRE((mmu.interruptFlags() & Mmu::INTERRUPT_JOYPAD) != 0);
+
+    mmu.write(Address(0xFF00), 0x10);
+    REQUIRE((mmu.read(Address(0xFF00)) & 0x0F) == 0x07);
+
+    mmu.write(Address(0xFF00), 0x20);
+    REQUIRE((mmu.read(Address(0xFF00)) & 0x0F) == 0x0D);
+}
+
+TEST_CASE("CGB VRAM and WRAM banks are switched through VBK and SVBK", "[mmu]")
+{
+    Mmu mmu(makeCartridge(0x00, 2, 0x00, true));
+
+    mmu.write(Address(0x8000), 0x11);
+    mmu.write(Address(0xFF4F), 0x01);
+    REQUIRE(mmu.read(Address(0x8000)) == 0x00);
+    mmu.write(Address(0x8000), 0x22);
+    mmu.write(Address(0xFF4F), 0x00);
+    REQUIRE(mmu.read(Address(0x8000)) == 0x11);
+
+    mmu.write(Address(0xD000), 0x33);
+    mmu.write(Address(0xFF70), 0x05);
+    REQUIRE(mmu.read(Address(0xD000)) == 0x00);
+    mmu.write(Address(0xF000), 0x44);
+    REQUIRE(mmu.read(Address(0xD000)) == 0x44);
+
+    // Bank 0 selects bank 1
+    mmu.write(Address(0xFF70), 0x00);
+    REQUIRE(mmu.read(Address(0xD000)) == 0x33);
+}
+
+TEST_CASE("General purpose HDMA copies to VRAM and stalls the cpu", "[mmu]")
+{
+    Mmu mmu(makeCartridge(0x00, 2, 0x00, true));
+
+    for (std::uint16_t i = 0; i < 0x20; ++i)
+    {
+        mmu.write(Address(static_cast<std::uint16_t>(0xC0F0 + i)), static_cast<std::uint8_t>(i + 1));
+    }
+
+    mmu.write(Address(0xFF51), 0xC0);
+    mmu.write(Address(0xFF52), 0xF0);
+    mmu.write(Address(0xFF53), 0x01);
+    mmu.write(Address(0xFF54), 0x00);
+    mmu.write(Address(0xFF55), 0x01);
+
+    REQUIRE(mmu.read(Address(0x8100)) == 0x01);
+    REQUIRE(mmu.read(Address(0x811F)) == 0x20);
+    REQUIRE(mmu.read(Address(0xFF55)) == 0xFF);
+    REQUIRE(mmu.takeStallCycles() == 16);
+}
+
+TEST_CASE("STOP switches speed only when armed through KEY1", "[mmu]")
+{
+    Mmu mmu(makeCartridge(0x00, 2, 0x00, true));
+
+    mmu.stop();
+    REQUIRE(!mmu.doubleSpeed());
+
+    mmu.write(Address(0xFF4D), 0x01);
+    mmu.stop();
+    REQUIRE(mmu.doubleSpeed());
+    REQUIRE(mmu.read(Address(0xFF4D)) == 0xFE);
+}
+
+TEST_CASE("Unsupported cartridge types are rejected", "[mmu]")
+{
+    REQUIRE_THROWS_AS(makeCartridge(0x13, 2), BadCartridgeException);
+}
+
+TEST_CASE("The boot ROM is unmapped by a write to 0xFF50", "[mmu]")
+{
+    Mmu mmu(makeCartridge(0x00, 2), std::vector<std::uint8_t>(Mmu::DMG_BOOT_ROM_SIZE, 0xAA));
+    REQUIRE(mmu.bootRomMapped());
+    REQUIRE(mmu.read(Address(0x0000)) == 0xAA);
+    REQUIRE(mmu.read(Address(0x0100)) == 0x00);
+
+    mmu.write(Address(0xFF50), 0x00);
+    REQUIRE(mmu.read(Address(0x00FF)) == 0xAA);
+
+    mmu.write(Address(0xFF50), 0x01);
+    REQUIRE_FALSE(mmu.bootRomMapped());
+    REQUIRE(mmu.read(Address(0x0000)) == 0x00);
+
+    REQUIRE_THROWS_AS(Mmu(makeCartridge(0x00, 2), std::vector<std::uint8_t>(0x200)), std::invalid_argument);
+}
+
+TEST_CASE("Without a boot ROM the machine starts in the post boot state", "[mmu]")
+{
+    GameBoy dmg(makeCartridge(0x00, 2));
+    REQUIRE(dmg.cpu().AF() == 0x01B0);
+    REQUIRE(dmg.cpu().PC() == 0x0100);
+    REQUIRE(dmg.mmu().read(Address(0xFF40)) == 0x91);
+    REQUIRE(dmg.mmu().read(Address(0xFF04)) == 0xAB);
+
+    GameBoy cgb(makeCartridge(0x00, 2, 0x00, true));
+    REQUIRE(cgb.cpu().AF() == 0x1180);
+    REQUIRE(cgb.cpu().HL() == 0x000D);
+}
+
+TEST_CASE("Cheat codes decode to patches and pokes", "[mmu]")
+{
+    auto const patch = parseGameGenie("00A-17B-C49");
+    REQUIRE(patch.address == 0x4A17);
+    REQUIRE(patch.value == 0x00);
+    REQUIRE(patch.compare == 0xC8);
+
+    auto const poke = parseGameShark("010238CD");
+    REQUIRE(poke.address == 0xCD38);
+    REQUIRE(poke.value == 0x02);
+    REQUIRE_FALSE(poke.wramBank);
+
+    REQUIRE_THROWS_AS(parseGameGenie("00A-17"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parseGameShark("01020080"), std::invalid_argument);
+}
+
+TEST_CASE("Rom patches only apply to banks holding the compare byte", "[mmu]")
+{
+    Mmu mmu(makeCartridge(0x01, 8));
+    mmu.setRomPatches({
+        {.address = 0x4010, .value = 0xAA, .compare = 0x03},
+        {.address = 0x4011, .value = 0xBB, .compare = std::nullopt},
+        {.address = 0x0000, .value = 0xCC, .compare = std::nullopt},
+    });
+
+    REQUIRE(mmu.read(Address(0x0000)) == 0xCC);
+    REQUIRE(mmu.read(Address(0x4010)) == 1);
+    REQUIRE(mmu.read(Address(0x4011)) == 0xBB);
+
+    mmu.write(Address(0x2000), 0x03);
+    REQUIRE(mmu.read(Address(0x4010)) == 0xAA);
+    REQUIRE(mmu.read(Address(0x400F)) == 3);
+
+    mmu.setRomPatches({});
+    REQUIRE(mmu.read(Address(0x0000)) == 0x00);
+    REQUIRE(mmu.read(Address(0x4011)) == 3);
+}
+
+TEST_CASE("Ram pokes are written at the start of VBlank", "[mmu]")
+{
+    Mmu mmu(makeCartridge(0x00, 2, 0x00, true));
+    mmu.setRamPokes({parseGameShark("0142FEFF"), parseGameShark("01420FC1"), parseGameShark("934308D0")});
+
+    while (mmu.read(Address(0xFF44)) != Mmu::VBLANK_LINE)
+    {
+        mmu.tick();
+    }
+    REQUIRE(mmu.read(Address(0xC10F)) == 0x42);
+    REQUIRE(mmu.read(Address(0xFFFE)) == 0x42);
+
+    mmu.write(Address(0xFF70), 0x03);
+    REQUIRE(mmu.read(Address(0xD008)) == 0x43);
+}
\ No newline at end of file
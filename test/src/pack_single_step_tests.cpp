@@ -0,0 +1,78 @@
+// Converts the SingleStepTests json files into the binary corpus read by unit_tests
+//
+// usage: pack_single_step_tests <json_dir> [<output_dir>]
+
+#include <cstdlib>
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <simdjson.h>
+
+#include "single_step_corpus.hpp"
+
+namespace
+{
+int pack(std::filesystem::path const& inputDir, std::filesystem::path const& outputDir)
+{
+    std::vector<std::filesystem::path> inputs;
+    for (auto const& entry : std::filesystem::directory_iterator(inputDir))
+    {
+        if (entry.is_regular_file() && (entry.path().extension() == ".json"))
+        {
+            inputs.push_back(entry.path());
+        }
+    }
+    std::ranges::sort(inputs);
+
+    std::filesystem::create_directories(outputDir);
+
+    simdjson::ondemand::parser parser;
+    std::string buffer;
+    std::vector<Corpus::Record> records;
+
+    for (auto const& input : inputs)
+    {
+        auto const opcode = Corpus::opcodeFromFilename(input);
+        auto const output = (outputDir / Corpus::filenameFromOpcode(opcode, ".bin"));
+
+        auto document = Corpus::loadJson(input, parser, buffer);
+
+        records.clear();
+        simdjson::ondemand::array json = document;
+        for (simdjson::ondemand::object testJson : json)
+        {
+            Corpus::parseRecord(testJson, records.emplace_back());
+        }
+
+        Corpus::writeCorpus(output, opcode, records);
+        std::cout << std::format("{} -> {} ({} tests)\n", input.c_str(), output.c_str(), records.size());
+    }
+
+    return EXIT_SUCCESS;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if ((argc != 2) && (argc != 3))
+    {
+        std::cerr << "usage: pack_single_step_tests <json_dir> [<output_dir>]\n";
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        std::filesystem::path const inputDir = argv[1];
+        return pack(inputDir, ((argc == 3) ? std::filesystem::path(argv[2]) : inputDir));
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <array>
+
+#include <fauxboy/frame.hpp>
+#include <fauxboy/palette.hpp>
+
+using namespace fxb;
+
+TEST_CASE("Palette data writes update the host color table", "[palette]")
+{
+    PaletteRam palettes;
+
+    // Background palette 1 color 2, auto increment
+    palettes.setBackgroundSpec(0x80 | 0x0C);
+    palettes.writeBackgroundData(0x1F);
+    palettes.writeBackgroundData(0x00);
+
+    REQUIRE(palettes.backgroundSpec() == (0xC0 | 0x0E));
+    REQUIRE(palettes.hostColors()[6] == 0xFFFF0000);
+
+    // Object palette 0 color 0, no increment so the second write replaces the low byte
+    palettes.setObjectSpec(0x00);
+    palettes.writeObjectData(0x00);
+    palettes.writeObjectData(0x7C);
+    REQUIRE(palettes.objectSpec() == 0x40);
+    REQUIRE(palettes.objectData() == 0x7C);
+}
+
+TEST_CASE("Color correction converts the whole table again", "[palette]")
+{
+    PaletteRam palettes;
+    REQUIRE(palettes.hostColors()[0] == 0xFFFFFFFF);
+
+    palettes.setColorCorrection(ColorCorrection::LCD);
+    REQUIRE(palettes.hostColors()[0] == 0xFFF8F8F8);
+    REQUIRE(palettes.hostColors()[PaletteRam::HOST_COLORS - 1] == 0xFFF8F8F8);
+}
+
+TEST_CASE("Indexed frames resolve through the host color table", "[palette]")
+{
+    PaletteRam palettes;
+    palettes.setObjectSpec(0x80);
+    palettes.writeObjectData(0x00);
+    palettes.writeObjectData(0x00);
+
+    IndexedFramebuffer frame;
+    frame.at(3, 2) = PaletteRam::OBJECT_COLORS_OFFSET;
+
+    HostFramebuffer output;
+    resolve(frame, palettes.hostColors(), output);
+
+    REQUIRE(output[(2 * SCREEN_WIDTH) + 3] == 0xFF000000);
+    REQUIRE(output[0] == 0xFFFFFFFF);
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <fauxboy/frame.hpp>
+#include <fauxboy/recorder.hpp>
+#include <fauxboy/spsc_queue.hpp>
+
+using namespace fxb;
+
+TEST_CASE("The spsc queue hands items over in order", "[recorder]")
+{
+    SpscQueue<int, 4> queue;
+    for (int i = 0; i < 4; ++i)
+    {
+        REQUIRE(queue.tryPush([i](int& slot) { slot = i; }));
+    }
+    REQUIRE_FALSE(queue.tryPush([](int& slot) { slot = -1; }));
+
+    std::vector<int> popped;
+    while (queue.tryPop([&popped](int const& slot) { popped.push_back(slot); }))
+    {
+    }
+    REQUIRE(popped == std::vector{0, 1, 2, 3});
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE("Repeated frames still end up in the video", "[recorder]")
+{
+    auto const directory = std::filesystem::temp_directory_path();
+    Recorder::Options options;
+    options.video = (directory / "fauxboy_recorder_test.y4m");
+    options.audio = (directory / "fauxboy_recorder_test.wav");
+
+    // Only the frame is too large for the stack, the recorder keeps its queue on the heap
+    STATIC_REQUIRE(sizeof(Recorder) < 4096);
+    Recorder recorder(options);
+    auto frame = std::make_unique<HostFramebuffer>();
+    frame->fill(0xFFFFFFFF);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        recorder.pushFrame(*frame);
+    }
+    (*frame)[0] = 0xFF000000;
+    recorder.pushFrame(*frame);
+
+    auto const samples = std::vector<std::int16_t>(((Recorder::MAX_AUDIO_SAMPLES * 2) + 2), 0);
+    recorder.pushAudio(samples);
+    recorder.close();
+
+    constexpr std::string_view HEADER   = "YUV4MPEG2 W160 H144 F4194304:70224 Ip A1:1 C444 XCOLORRANGE=FULL\n";
+    constexpr std::uintmax_t FRAME_SIZE = (std::string_view("FRAME\n").size() + (3 * SCREEN_PIXELS));
+    REQUIRE(std::filesystem::file_size(options.video) == (HEADER.size() + (6 * FRAME_SIZE)));
+    REQUIRE(std::filesystem::file_size(options.audio) == (44 + (samples.size() * sizeof(std::int16_t))));
+
+    std::filesystem::remove(options.video);
+    std::filesystem::remove(options.audio);
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <fauxboy/cartridge.hpp>
+#include <fauxboy/cheats.hpp>
+#include <fauxboy/game_boy.hpp>
+#include <fauxboy/mmu.hpp>
+#include <fauxboy/run_ahead.hpp>
+
+#include "test_rom.hpp"
+
+using namespace fxb;
+
+namespace
+{
+constexpr std::uint32_t FRAMES_AHEAD = 2;
+constexpr int FRAMES                 = 6;
+constexpr std::uint8_t BUTTONS       = (Mmu::BUTTON_A | Mmu::BUTTON_RIGHT);
+
+// ADD (HL) becomes ADD B and 0xC010 is reset to 0x42 at every VBlank
+void setCheats(GameBoy& gameBoy)
+{
+    gameBoy.mmu().setRomPatches({{.address = 0x0109, .value = 0x80, .compare = 0x86}});
+    gameBoy.mmu().setRamPokes({parseGameShark("014210C0")});
+}
+
+// Hash of the plain machine after every frame
+std::vector<std::uint64_t> expectedHashes(bool cheats)
+{
+    GameBoy reference{Cartridge(TestRom::build(TestRom::BUTTON_COUNTER))};
+    if (cheats)
+    {
+        setCheats(reference);
+    }
+    reference.mmu().setButtons(BUTTONS);
+
+    std::vector<std::uint64_t> hashes;
+    for (std::uint32_t frame = 0; frame < (FRAMES + FRAMES_AHEAD); ++frame)
+    {
+        reference.runFrame();
+        hashes.push_back(reference.hash());
+    }
+    return hashes;
+}
+} // namespace
+
+TEST_CASE("Run ahead shows what the machine shows frames later", "[run_ahead]")
+{
+    auto const mode   = GENERATE(RunAhead::Mode::Restore, RunAhead::Mode::SecondInstance);
+    auto const cheats = GENERATE(false, true);
+
+    auto const expected = expectedHashes(cheats);
+
+    // Cheats set after the helper exists still have to reach the shadow
+    GameBoy gameBoy{Cartridge(TestRom::build(TestRom::BUTTON_COUNTER))};
+    RunAhead runAhead(gameBoy, FRAMES_AHEAD, mode);
+    if (cheats)
+    {
+        setCheats(gameBoy);
+    }
+
+    for (int frame = 0; frame < FRAMES; ++frame)
+    {
+        std::uint64_t shown = 0;
+        runAhead.runFrame(BUTTONS, [&shown](GameBoy const& ahead) { shown = ahead.hash(); });
+
+        // The ahead picture is the one the machine reaches later, the machine itself only moved by one frame
+        INFO("frame " << frame << (cheats ? " with cheats" : ""));
+        REQUIRE(shown == expected[frame + FRAMES_AHEAD]);
+        REQUIRE(gameBoy.hash() == expected[frame]);
+    }
+}
+
+TEST_CASE("The cheats of the run ahead test change the machine", "[run_ahead]")
+{
+    REQUIRE(expectedHashes(true) != expectedHashes(false));
+}
+
+TEST_CASE("Serial output of frames run ahead reaches the host once", "[run_ahead]")
+{
+    // loop: LD A,0x81; LDH (0x02),A; JR loop
+    constexpr std::uint8_t SERIAL[] = {0x3E, 0x81, 0xE0, 0x02, 0x18, 0xFA};
+
+    auto const mode = GENERATE(RunAhead::Mode::Restore, RunAhead::Mode::SecondInstance);
+
+    std::uint64_t expected = 0;
+    GameBoy reference{Cartridge(TestRom::build(SERIAL))};
+    reference.mmu().setOnSerialCallback([&expected](std::uint8_t) { ++expected; });
+
+    std::uint64_t sent = 0;
+    GameBoy gameBoy{Cartridge(TestRom::build(SERIAL))};
+    gameBoy.mmu().setOnSerialCallback([&sent](std::uint8_t) { ++sent; });
+    RunAhead runAhead(gameBoy, FRAMES_AHEAD, mode);
+
+    for (int frame = 0; frame < FRAMES; ++frame)
+    {
+        reference.runFrame();
+        runAhead.runFrame(0, [](GameBoy const&) {});
+        REQUIRE(sent == expected);
+    }
+    REQUIRE(sent > 0);
+}
+
+TEST_CASE("Run ahead by zero frames shows the machine itself", "[run_ahead]")
+{
+    GameBoy gameBoy{Cartridge(TestRom::build(TestRom::BUTTON_COUNTER))};
+    RunAhead runAhead(gameBoy, 0, RunAhead::Mode::SecondInstance);
+
+    GameBoy const* shown = nullptr;
+    runAhead.runFrame(0, [&shown](GameBoy const& ahead) { shown = &ahead; });
+    REQUIRE(shown == &gameBoy);
+}
\ No newline at end of file
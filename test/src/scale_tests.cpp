@@ -0,0 +1,82 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <array>
+#include <vector>
+
+#include <fauxboy/frame.hpp>
+#include <fauxboy/palette.hpp>
+#include <fauxboy/scale.hpp>
+
+using namespace fxb;
+
+namespace
+{
+// Index i maps to a gray of value 4 * i
+std::array<HostColor, PaletteRam::HOST_COLORS> makeColors()
+{
+    std::array<HostColor, PaletteRam::HOST_COLORS> colors;
+    for (std::uint32_t i = 0; i < colors.size(); ++i)
+    {
+        auto const value = (4 * i);
+        colors[i]        = (0xFF000000 | (value << 16) | (value << 8) | value);
+    }
+    return colors;
+}
+} // namespace
+
+TEST_CASE("Nearest neighbour upscaling repeats every pixel", "[scale]")
+{
+    auto const colors = makeColors();
+    IndexedFramebuffer frame;
+    frame.at(1, 0) = 1;
+
+    std::vector<HostColor> output(SCREEN_PIXELS * 9);
+    upscaleNearest(frame, colors, 3, output);
+
+    auto const width = (3 * SCREEN_WIDTH);
+    REQUIRE(output[2] == colors[0]);
+    REQUIRE(output[3] == colors[1]);
+    REQUIRE(output[(2 * width) + 5] == colors[1]);
+    REQUIRE(output[(3 * width) + 3] == colors[0]);
+
+    std::vector<HostColor> tooSmall(SCREEN_PIXELS);
+    REQUIRE_THROWS_AS(upscaleNearest(frame, colors, 2, tooSmall), std::invalid_argument);
+}
+
+TEST_CASE("Smoothing rounds off a diagonal", "[scale]")
+{
+    auto const colors = makeColors();
+    IndexedFramebuffer frame;
+    frame.at(10, 10) = 1;
+    frame.at(11, 10) = 1;
+    frame.at(10, 11) = 1;
+
+    std::vector<HostColor> output(SCREEN_PIXELS * 4);
+    smooth2x(frame, colors, output);
+
+    // The inner corner of the L shape at 11,11 gets filled, its other pixels stay
+    auto const width = (2 * SCREEN_WIDTH);
+    REQUIRE(output[(22 * width) + 22] == colors[1]);
+    REQUIRE(output[(22 * width) + 23] == colors[0]);
+    REQUIRE(output[(23 * width) + 23] == colors[0]);
+}
+
+TEST_CASE("Downsampling averages blocks of the crop", "[scale]")
+{
+    auto const colors = makeColors();
+    IndexedFramebuffer frame;
+    frame.at(8, 4) = 4;
+    frame.at(9, 5) = 8;
+
+    std::vector<HostColor> output(4 * 2);
+    downsample(frame, colors, 2, output, {.x = 6, .y = 4, .width = 8, .height = 4});
+
+    // (16 + 32) / 4
+    REQUIRE(output[0] == colors[0]);
+    REQUIRE(output[1] == 0xFF0C0C0C);
+
+    REQUIRE_THROWS_AS(downsample(frame, colors, 3, output), std::invalid_argument);
+    REQUIRE_THROWS_AS(downsample(frame, colors, 2, output, {.x = 6, .y = 4, .width = 7, .height = 4}),
+                      std::invalid_argument);
+}
\ No newline at end of file
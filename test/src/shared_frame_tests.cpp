@@ -0,0 +1,40 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <format>
+#include <memory>
+
+#include <unistd.h>
+
+#include <fauxboy/frame.hpp>
+#include <fauxboy/shared_frame.hpp>
+
+using namespace fxb;
+
+TEST_CASE("Viewers see the latest published frame", "[shared_frame]")
+{
+    auto const name = std::format("/fauxboy-test-{}", getpid());
+
+    SharedFrameWriter writer(name);
+    SharedFrameReader const reader(name);
+    REQUIRE(reader.generation() == 0);
+
+    auto frame = std::make_unique<HostFramebuffer>();
+    for (std::uint32_t i = 1; i <= 4; ++i)
+    {
+        frame->fill(i);
+        writer.publish(*frame);
+    }
+    writer.beginFrame().fill(5);
+    writer.publish();
+
+    auto seen = std::make_unique<HostFramebuffer>();
+    reader.read(*seen);
+    REQUIRE(reader.generation() == 5);
+    REQUIRE((*seen)[0] == 5);
+    REQUIRE((*seen)[SCREEN_PIXELS - 1] == 5);
+
+    // A buffer that is being drawn into is never handed out as the latest one
+    writer.beginFrame().fill(6);
+    REQUIRE(reader.tryRead([](HostFramebuffer const& latest) { REQUIRE(latest[0] == 5); }));
+}
\ No newline at end of file
@@ -0,0 +1,320 @@
+// Reuses the SingleStepTests vectors as a cpu throughput benchmark, every vector is a reset followed by a single step
+// with no tick callback installed
+//
+// usage: single_step_bench <tests_dir> [--repeats N] [--per-opcode]
+
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <simdjson.h>
+
+#include <fauxboy/address.hpp>
+#include <fauxboy/cpu.hpp>
+#include <fauxboy/flat_bus.hpp>
+#include <fauxboy/util.hpp>
+
+#include "single_step_corpus.hpp"
+
+using namespace fxb;
+
+namespace
+{
+struct Options
+{
+    std::filesystem::path testsDir;
+    int repeats    = 20;
+    bool perOpcode = false;
+};
+
+struct OpcodeVectors
+{
+    std::uint16_t opcode;
+    std::vector<Corpus::Record> records;
+};
+
+struct Timing
+{
+    std::size_t vectors = 0;
+    double nanoseconds  = 0.0;
+
+    [[nodiscard]] double perInstruction() const noexcept { return (nanoseconds / static_cast<double>(vectors)); }
+};
+
+std::string_view opcodeClass(std::uint16_t opcode)
+{
+    if (getUpper(opcode) == 0xCB)
+    {
+        auto const offset = getLower(opcode);
+        if (offset < 0x40)
+        {
+            return "cb rotate/shift";
+        }
+        if (offset < 0x80)
+        {
+            return "cb bit";
+        }
+        return "cb res/set";
+    }
+
+    auto const column = (opcode & 0x0F);
+    if ((opcode >= 0x40) && (opcode < 0x80))
+    {
+        return ((opcode == 0x76) ? "misc" : "load");
+    }
+    if ((opcode >= 0x80) && (opcode < 0xC0))
+    {
+        return "alu";
+    }
+    if (opcode < 0x40)
+    {
+        switch (column)
+        {
+            case 0x01:
+            case 0x03:
+            case 0x09:
+            case 0x0B: return "16-bit";
+            case 0x04:
+            case 0x05:
+            case 0x0C:
+            case 0x0D: return "inc/dec";
+            case 0x02:
+            case 0x06:
+            case 0x0A:
+            case 0x0E: return "load";
+            default: break;
+        }
+        if (opcode == 0x08)
+        {
+            return "load";
+        }
+        if ((opcode == 0x18) || (opcode == 0x20) || (opcode == 0x28) || (opcode == 0x30) || (opcode == 0x38))
+        {
+            return "control";
+        }
+        return "misc";
+    }
+
+    switch (column)
+    {
+        case 0x01:
+        case 0x05: return "stack";
+        case 0x06:
+        case 0x0E: return "alu";
+        case 0x07:
+        case 0x0F: return "control";
+        default: break;
+    }
+
+    switch (opcode)
+    {
+        case 0xE0:
+        case 0xF0:
+        case 0xE2:
+        case 0xF2:
+        case 0xEA:
+        case 0xFA: return "load";
+        case 0xE8:
+        case 0xF8:
+        case 0xF9: return "16-bit";
+        case 0xF3:
+        case 0xFB: return "misc";
+        default: return "control";
+    }
+}
+
+std::vector<OpcodeVectors> loadVectors(std::filesystem::path const& testsDir)
+{
+    std::map<std::uint16_t, std::filesystem::path> files;
+    for (auto const& entry : std::filesystem::directory_iterator(testsDir))
+    {
+        auto const& path = entry.path();
+        if (!entry.is_regular_file() || ((path.extension() != ".bin") && (path.extension() != ".json")))
+        {
+            continue;
+        }
+
+        // The packed corpus wins over json when both are present
+        auto const opcode = Corpus::opcodeFromFilename(path);
+        if (!files.contains(opcode) || (path.extension() == ".bin"))
+        {
+            files[opcode] = path;
+        }
+    }
+
+    simdjson::ondemand::parser parser;
+    std::string buffer;
+
+    std::vector<OpcodeVectors> vectors;
+    for (auto const& [opcode, path] : files)
+    {
+        auto& entry  = vectors.emplace_back();
+        entry.opcode = opcode;
+
+        if (path.extension() == ".bin")
+        {
+            auto const corpus = Corpus::CorpusFile(path);
+            entry.records.assign(corpus.records().begin(), corpus.records().end());
+            continue;
+        }
+
+        auto document                  = Corpus::loadJson(path, parser, buffer);
+        simdjson::ondemand::array json = document;
+        for (simdjson::ondemand::object testJson : json)
+        {
+            Corpus::parseRecord(testJson, entry.records.emplace_back());
+        }
+    }
+
+    return vectors;
+}
+
+// Best of several repeats, the setup only pass loads the same ram slots and registers without stepping so its cost can
+// be taken out of the measurement
+Timing measure(OpcodeVectors const& vectors, int repeats, FlatBus& bus, Cpu& cpu)
+{
+    using Clock = std::chrono::steady_clock;
+
+    auto const run = [&](bool step)
+    {
+        auto const start = Clock::now();
+        for (auto const& record : vectors.records)
+        {
+            for (auto const& slot : record.initial.slots())
+            {
+                bus.write(Address(slot.address), slot.value);
+            }
+            cpu.reset(record.initial.registers.toCpuState());
+            if (step)
+            {
+                cpu.step();
+            }
+        }
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    };
+
+    double best      = std::numeric_limits<double>::max();
+    double bestSetup = std::numeric_limits<double>::max();
+    for (int i = 0; i < repeats; ++i)
+    {
+        best      = std::min(best, run(true));
+        bestSetup = std::min(bestSetup, run(false));
+    }
+
+    return {.vectors = vectors.records.size(), .nanoseconds = std::max(0.0, (best - bestSetup))};
+}
+
+Options parseOptions(int argc, char* argv[])
+{
+    Options options;
+    bool hasDir = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view const arg = argv[i];
+        if (arg == "--repeats")
+        {
+            if ((i + 1) >= argc)
+            {
+                throw std::invalid_argument(std::format("Missing value for {}", arg));
+            }
+            options.repeats = std::max(1, std::stoi(argv[++i]));
+        }
+        else if (arg == "--per-opcode")
+        {
+            options.perOpcode = true;
+        }
+        else if (!hasDir)
+        {
+            options.testsDir = arg;
+            hasDir           = true;
+        }
+        else
+        {
+            throw std::invalid_argument(std::format("Unknown argument: {}", arg));
+        }
+    }
+
+    if (!hasDir)
+    {
+        throw std::invalid_argument("usage: single_step_bench <tests_dir> [--repeats N] [--per-opcode]");
+    }
+    return options;
+}
+
+int bench(Options const& options)
+{
+    auto const vectors = loadVectors(options.testsDir);
+    if (vectors.empty())
+    {
+        throw std::runtime_error(std::format("No test files found in {}", options.testsDir.c_str()));
+    }
+
+    FlatBus bus;
+    Cpu cpu(&bus);
+
+    std::map<std::string_view, Timing> classes;
+    Timing total;
+
+    if (options.perOpcode)
+    {
+        std::cout << std::format("{:<8}{:<18}{:>10}{:>14}\n", "opcode", "class", "vectors", "ns/instr");
+    }
+
+    for (auto const& entry : vectors)
+    {
+        auto const timing = measure(entry, options.repeats, bus, cpu);
+        auto const name   = opcodeClass(entry.opcode);
+
+        auto& classTiming = classes[name];
+        classTiming.vectors += timing.vectors;
+        classTiming.nanoseconds += timing.nanoseconds;
+
+        total.vectors += timing.vectors;
+        total.nanoseconds += timing.nanoseconds;
+
+        if (options.perOpcode)
+        {
+            std::cout << std::format(
+                "0x{:<6X}{:<18}{:>10}{:>14.2f}\n", entry.opcode, name, timing.vectors, timing.perInstruction());
+        }
+    }
+
+    if (options.perOpcode)
+    {
+        std::cout << '\n';
+    }
+
+    std::cout << std::format("{:<18}{:>10}{:>14}\n", "class", "vectors", "ns/instr");
+    for (auto const& [name, timing] : classes)
+    {
+        std::cout << std::format("{:<18}{:>10}{:>14.2f}\n", name, timing.vectors, timing.perInstruction());
+    }
+    std::cout << std::format("{:<18}{:>10}{:>14.2f}\n", "all", total.vectors, total.perInstruction());
+
+    return EXIT_SUCCESS;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        return bench(parseOptions(argc, argv));
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}
\ No newline at end of file
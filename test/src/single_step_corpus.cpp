@@ -0,0 +1,248 @@
+#include "single_step_corpus.hpp"
+
+#include <cstdint>
+#include <cctype>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <simdjson.h>
+
+#include <fauxboy/util.hpp>
+
+namespace Corpus
+{
+namespace
+{
+template <typename T, typename Itr>
+T parseNextAs(Itr& itr)
+{
+    T const result = (*itr).template get<T>();
+    ++itr;
+    return result;
+}
+
+CycleMode parseCycleMode(std::string_view mode)
+{
+    if (mode == "r-m")
+    {
+        return CycleMode::READ;
+    }
+    if (mode == "-wm")
+    {
+        return CycleMode::WRITE;
+    }
+    if (mode == "---")
+    {
+        return CycleMode::INTERNAL;
+    }
+    throw std::runtime_error(std::format("Unknown cycle mode: {}", mode));
+}
+
+void parseState(simdjson::ondemand::object json, State& state)
+{
+    auto& registers = state.registers;
+    registers.A     = json["a"].get<std::uint8_t>();
+    registers.B     = json["b"].get<std::uint8_t>();
+    registers.C     = json["c"].get<std::uint8_t>();
+    registers.D     = json["d"].get<std::uint8_t>();
+    registers.E     = json["e"].get<std::uint8_t>();
+    registers.F     = json["f"].get<std::uint8_t>();
+    registers.H     = json["h"].get<std::uint8_t>();
+    registers.L     = json["l"].get<std::uint8_t>();
+    registers.PC    = json["pc"].get<std::uint16_t>();
+    registers.SP    = json["sp"].get<std::uint16_t>();
+
+    state.ramCount = 0;
+    for (simdjson::ondemand::array slotJson : json["ram"])
+    {
+        if (state.ramCount == MAX_RAM_SLOTS)
+        {
+            throw std::runtime_error(std::format("More than {} ram slots", MAX_RAM_SLOTS));
+        }
+
+        auto itr      = slotJson.begin();
+        auto& slot    = state.ram[state.ramCount++];
+        slot.address  = parseNextAs<std::uint16_t>(itr);
+        slot.value    = parseNextAs<std::uint8_t>(itr);
+        slot.reserved = 0;
+    }
+}
+} // namespace
+
+void parseRecord(simdjson::ondemand::object json, Record& record)
+{
+    std::string_view const name = json["name"];
+    if (name.size() >= MAX_NAME_LENGTH)
+    {
+        throw std::runtime_error(std::format("Test name too long: {}", name));
+    }
+    record.name.fill('\0');
+    std::ranges::copy(name, record.name.begin());
+
+    parseState(json["initial"], record.initial);
+    parseState(json["final"], record.final);
+
+    record.cycleCount = 0;
+    for (simdjson::ondemand::array cycleJson : json["cycles"])
+    {
+        if (record.cycleCount == MAX_CYCLES)
+        {
+            throw std::runtime_error(std::format("More than {} cycles in {}", MAX_CYCLES, name));
+        }
+
+        auto itr      = cycleJson.begin();
+        auto& cycle   = record.cycles[record.cycleCount++];
+        cycle.address = parseNextAs<std::uint16_t>(itr);
+        cycle.data    = parseNextAs<std::uint8_t>(itr);
+        cycle.mode    = parseCycleMode(parseNextAs<std::string_view>(itr));
+    }
+}
+
+simdjson::ondemand::document loadJson(std::filesystem::path const& path,
+                                      simdjson::ondemand::parser& parser,
+                                      std::string& buffer)
+{
+    auto ifs = std::ifstream(path, std::ios::binary);
+    if (!ifs.is_open())
+    {
+        throw std::runtime_error(std::format("Could not open file: {}", path.c_str()));
+    }
+
+    ifs.seekg(0, std::ios::end);
+    auto const fileSize = ifs.tellg();
+    ifs.seekg(0, std::ios::beg);
+
+    buffer.resize(fileSize, '\0');
+    std::copy(std::istreambuf_iterator(ifs), {}, buffer.begin());
+
+    return parser.iterate(simdjson::pad(buffer));
+}
+
+void writeCorpus(std::filesystem::path const& path, std::uint16_t opcode, std::span<Record const> records)
+{
+    auto ofs = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open())
+    {
+        throw std::runtime_error(std::format("Could not open file: {}", path.c_str()));
+    }
+
+    Header header;
+    header.recordCount = static_cast<std::uint32_t>(records.size());
+    header.opcode      = opcode;
+
+    ofs.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    ofs.write(reinterpret_cast<char const*>(records.data()), static_cast<std::streamsize>(records.size_bytes()));
+
+    if (!ofs)
+    {
+        throw std::runtime_error(std::format("Could not write file: {}", path.c_str()));
+    }
+}
+
+CorpusFile::CorpusFile(std::filesystem::path const& path)
+{
+    int const fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::runtime_error(std::format("Could not open file: {}", path.c_str()));
+    }
+
+    struct stat info = {};
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        throw std::runtime_error(std::format("Could not stat file: {}", path.c_str()));
+    }
+
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ < sizeof(Header))
+    {
+        close(fd);
+        throw std::runtime_error(std::format("Truncated corpus file: {}", path.c_str()));
+    }
+
+    void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        throw std::runtime_error(std::format("Could not map file: {}", path.c_str()));
+    }
+    mapping_ = mapping;
+
+    auto const* bytes = static_cast<std::uint8_t const*>(mapping_);
+    std::memcpy(&header_, bytes, sizeof(header_));
+
+    auto const fail = [this, &path](std::string_view reason)
+    {
+        munmap(const_cast<void*>(mapping_), size_);
+        return std::runtime_error(std::format("{}: {}", reason, path.c_str()));
+    };
+
+    if (header_.magic != MAGIC)
+    {
+        throw fail("Not a corpus file");
+    }
+    if ((header_.version != VERSION) || (header_.recordSize != sizeof(Record)))
+    {
+        throw fail(std::format("Corpus version {} is not supported, expected {}", header_.version, VERSION));
+    }
+    if ((size_ - sizeof(Header)) != (std::size_t{header_.recordCount} * sizeof(Record)))
+    {
+        throw fail("Truncated corpus file");
+    }
+
+    madvise(const_cast<void*>(mapping_), size_, MADV_SEQUENTIAL);
+    records_ = {reinterpret_cast<Record const*>(bytes + sizeof(Header)), header_.recordCount};
+}
+
+CorpusFile::~CorpusFile()
+{
+    munmap(const_cast<void*>(mapping_), size_);
+}
+
+std::string filenameFromOpcode(std::uint16_t opcode, std::string_view extension)
+{
+    std::uint8_t const prefix = fxb::getUpper(opcode);
+    std::uint8_t const offset = fxb::getLower(opcode);
+
+    if (prefix == 0x00)
+    {
+        return std::format("{:02x}{}", offset, extension);
+    }
+    return std::format("{:02x} {:02x}{}", prefix, offset, extension);
+}
+
+std::uint16_t opcodeFromFilename(std::filesystem::path const& path)
+{
+    auto const stem = path.stem().string();
+
+    std::uint16_t opcode = 0;
+    for (char const c : stem)
+    {
+        if (c == ' ')
+        {
+            continue;
+        }
+
+        auto const digit = std::string_view("0123456789abcdef").find(static_cast<char>(std::tolower(c)));
+        if (digit == std::string_view::npos)
+        {
+            throw std::runtime_error(std::format("Not an opcode file name: {}", path.c_str()));
+        }
+        opcode = static_cast<std::uint16_t>((opcode << 4) | digit);
+    }
+    return opcode;
+}
+} // namespace Corpus
\ No newline at end of file
@@ -1,23 +1,28 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/interfaces/catch_interfaces_test_invoker.hpp>
+#include <catch2/internal/catch_test_registry.hpp>
+#include <catch2/internal/catch_unique_ptr.hpp>
 
 #include <string_view>
 #include <cstdint>
-#include <vector>
+#include <array>
 #include <algorithm>
 #include <filesystem>
 #include <format>
-#include <fstream>
-#include <stdexcept>
 #include <string>
+#include <span>
+#include <utility>
 
 #include <simdjson.h>
 
 #include <fauxboy/bus.hpp>
 #include <fauxboy/cpu.hpp>
+#include <fauxboy/recording_bus.hpp>
 #include <fauxboy/address.hpp>
 #include <fauxboy/util.hpp>
 
 #include "config.hpp"
+#include "single_step_corpus.hpp"
 
 using namespace fxb;
 
@@ -32,81 +37,96 @@ struct StringMaker<Address>
 
 namespace
 {
-struct MemoryAccess
+std::string formatOpcode(std::uint16_t opcode)
 {
-    Address address;
-    std::uint8_t data;
-    MemoryAccessMode accessMode;
-};
+    return ((getUpper(opcode) != 0x00) ? std::format("0x{:04X}", opcode) : std::format("0x{:02X}", getLower(opcode)));
+}
 
-class OpenBus : public Bus
+std::string formatCycle(BusActivity activity, std::uint16_t address, std::uint8_t data)
 {
-private:
-    std::vector<std::uint8_t> memory_;
-    MemoryAccess lastMemoryAccess_ = {.address = Address(0), .data = 0, .accessMode = MemoryAccessMode::READ};
-
-public:
-    OpenBus()
-        : memory_(1024 * 64, 0)
+    switch (activity)
     {
+        case BusActivity::IDLE: return "idle";
+        case BusActivity::READ: return std::format("read  0x{:04X} 0x{:02X}", address, data);
+        case BusActivity::WRITE: return std::format("write 0x{:04X} 0x{:02X}", address, data);
     }
+    std::unreachable();
+}
 
-    [[nodiscard]] MemoryAccess const& getLastMemoryAccess() const noexcept { return lastMemoryAccess_; }
-
-    void reset() { std::ranges::fill(memory_, 0); }
-
-    [[nodiscard]] std::uint8_t read(Address address) override
+BusActivity toBusActivity(Corpus::CycleMode mode)
+{
+    switch (mode)
     {
-        lastMemoryAccess_.address    = address;
-        lastMemoryAccess_.accessMode = MemoryAccessMode::READ;
-        return memory_[address.value];
+        case Corpus::CycleMode::INTERNAL: return BusActivity::IDLE;
+        case Corpus::CycleMode::READ: return BusActivity::READ;
+        case Corpus::CycleMode::WRITE: return BusActivity::WRITE;
     }
-    void write(Address address, std::uint8_t value) override
+    std::unreachable();
+}
+
+// Reads are checked on their address, writes on their address and data, internal cycles are not checked
+bool cycleMatches(Corpus::Cycle const& expected, BusCycle const& actual)
+{
+    switch (expected.mode)
     {
-        lastMemoryAccess_.address    = address;
-        lastMemoryAccess_.data       = value;
-        lastMemoryAccess_.accessMode = MemoryAccessMode::WRITE;
-        memory_[address.value]       = value;
+        case Corpus::CycleMode::INTERNAL: return true;
+        case Corpus::CycleMode::READ:
+        {
+            return ((actual.activity == BusActivity::READ) && (actual.address == expected.address));
+        }
+        case Corpus::CycleMode::WRITE:
+        {
+            return ((actual.activity == BusActivity::WRITE) && (actual.address == expected.address)
+                    && (actual.data == expected.data));
+        }
     }
-};
+    std::unreachable();
+}
 
-struct RamSlot
+std::string describeCycleLog(std::span<Corpus::Cycle const> expected, RecordingBus const& bus)
 {
-    Address address;
-    std::uint8_t value;
-};
+    auto const actual = bus.log();
 
-struct SystemState
-{
-    CpuState cpuState;
-    std::vector<RamSlot> ram;
-};
+    std::string description = std::format("{:<7}{:<24}{}\n", "cycle", "expected", "actual");
+    for (std::size_t i = 0; i < std::max(expected.size(), actual.size()); ++i)
+    {
+        std::string expectedText;
+        std::string actualText;
+        bool matches = false;
 
-struct BusState
-{
-    Address address;
-    std::uint8_t data;
-    std::string_view accessMode;
-};
+        if (i < expected.size())
+        {
+            auto const& cycle = expected[i];
+            expectedText      = formatCycle(toBusActivity(cycle.mode), cycle.address, cycle.data);
+        }
+        if (i < actual.size())
+        {
+            auto const& cycle = actual[i];
+            actualText        = formatCycle(cycle.activity, cycle.address.value, cycle.data);
+            matches           = ((i < expected.size()) && cycleMatches(expected[i], cycle));
+        }
 
-struct TestData
-{
-    std::string_view name;
-    SystemState initial;
-    SystemState final;
-    std::vector<BusState> cycles;
-};
+        description += std::format("{:<7}{:<24}{:<24}{}\n", i, expectedText, actualText, (matches ? "" : "<--"));
+    }
+
+    if (bus.cycleCount() > actual.size())
+    {
+        description += std::format("... {} more cycles not recorded\n", (bus.cycleCount() - actual.size()));
+    }
+
+    return description;
+}
 
 class SingleStepTestsFixture
 {
 private:
-    mutable simdjson::ondemand::parser parser_;
-    mutable std::string buffer_;
-    mutable std::filesystem::path filepath_ = (Config::SINGLE_STEP_TESTS_DIR / "dummy.json");
+    simdjson::ondemand::parser parser_;
+    std::string buffer_;
+    Corpus::Record record_;
 
 public:
     // Illegal opcodes and PREFIX instructions are ignored, nothing to test
-    static inline std::vector<std::uint16_t> opcodes = {
+    static constexpr auto opcodes = std::to_array<std::uint16_t>({
         // clang-format off
         // Unprefixed
         0x00, 0x01, 0x02,   0x03,   0x04,   0x05, 0x06, 0x07, 0x08, 0x09, 0x0A,   0x0B,   0x0C,   0x0D,   0x0E, 0x0F,
@@ -143,198 +163,143 @@ public:
         0xCBE0, 0xCBE1, 0xCBE2, 0xCBE3, 0xCBE4, 0xCBE5, 0xCBE6, 0xCBE7, 0xCBE8, 0xCBE9, 0xCBEA, 0xCBEB, 0xCBEC, 0xCBED, 0xCBEE, 0xCBEF,
         0xCBF0, 0xCBF1, 0xCBF2, 0xCBF3, 0xCBF4, 0xCBF5, 0xCBF6, 0xCBF7, 0xCBF8, 0xCBF9, 0xCBFA, 0xCBFB, 0xCBFC, 0xCBFD, 0xCBFE, 0xCBFF,
         // clang-format on
-    };
+    });
 
-    mutable OpenBus bus;
-    mutable Cpu cpu = Cpu(&bus);
+    RecordingBus bus;
+    Cpu cpu = Cpu(&bus);
 
-    mutable simdjson::ondemand::document document;
-    mutable TestData testData;
+    SingleStepTestsFixture()
+    {
+        cpu.setOnTickCallback([this](Cpu const*) { bus.endCycle(); });
+    }
 
 private:
-    void setFilepathFromOpcode(std::uint16_t opcode) const
+    void runTest(Corpus::Record const& test)
     {
-        std::uint8_t const prefix = getUpper(opcode);
-        std::uint8_t const offset = getLower(opcode);
+        auto const& initial = test.initial.registers;
+        auto const& final   = test.final.registers;
+        auto const cycles   = test.cycleLog();
 
-        switch (prefix)
+        INFO("test: " << test.testName());
+
+        for (auto const& slot : test.initial.slots())
         {
-            case 0x00:
-            {
-                filepath_.replace_filename(std::format("{:02x}.json", offset));
-                break;
-            }
-            default:
-            {
-                filepath_.replace_filename(std::format("{:02x} {:02x}.json", prefix, offset));
-                break;
-            }
+            bus.write(Address(slot.address), slot.value);
         }
-    }
 
-    void loadFile() const
-    {
-        auto ifs = std::ifstream(filepath_, std::ios::binary);
-        if (!ifs.is_open())
+        bus.clearLog();
+        cpu.reset(initial.toCpuState());
+
+        REQUIRE_NOTHROW(cpu.step());
+
+        // The whole bus log is compared once the instruction is done instead of asserting on every m-cycle
+        bool const logMatches
+            = ((bus.cycleCount() == cycles.size()) && std::ranges::equal(cycles, bus.log(), cycleMatches));
+        if (!logMatches)
         {
-            throw std::runtime_error(std::format("Could not open file: {}", filepath_.c_str()));
+            FAIL("bus cycles do not match\n" << describeCycleLog(cycles, bus));
         }
 
-        ifs.seekg(0, std::ios::end);
-        auto const fileSize = ifs.tellg();
-        ifs.seekg(0, std::ios::beg);
-
-        buffer_.resize(fileSize, '\0');
-        std::copy(std::istreambuf_iterator(ifs), {}, buffer_.begin());
+        REQUIRE(cpu.A() == final.A);
+        REQUIRE(cpu.B() == final.B);
+        REQUIRE(cpu.C() == final.C);
+        REQUIRE(cpu.D() == final.D);
+        REQUIRE(cpu.E() == final.E);
+        REQUIRE(cpu.F() == final.F);
+        REQUIRE(cpu.H() == final.H);
+        REQUIRE(cpu.L() == final.L);
+        REQUIRE(cpu.SP() == final.SP);
+        REQUIRE(cpu.PC() == final.PC);
+
+        REQUIRE(cpu.AF() == ((final.A << 8) | final.F));
+        REQUIRE(cpu.BC() == ((final.B << 8) | final.C));
+        REQUIRE(cpu.DE() == ((final.D << 8) | final.E));
+        REQUIRE(cpu.HL() == ((final.H << 8) | final.L));
+
+        for (auto const& slot : test.final.slots())
+        {
+            REQUIRE(bus.read(Address(slot.address)) == slot.value);
+        }
 
-        document = parser_.iterate(simdjson::pad(buffer_));
+        // Every address the instruction can touch is listed in the test, clearing those is enough to start the next
+        // test from zeroed memory without wiping all 64KiB
+        for (auto const& slot : test.initial.slots())
+        {
+            bus.write(Address(slot.address), 0);
+        }
+        for (auto const& slot : test.final.slots())
+        {
+            bus.write(Address(slot.address), 0);
+        }
     }
 
-    template <typename T, typename U, typename Itr>
-    void parseNextAs(Itr& itr, U& out) const
+public:
+    void run(std::uint16_t opcode)
     {
-        T result = (*itr).template get<T>();
-        out      = U(result);
-        ++itr;
-    }
+        INFO("opcode: " << formatOpcode(opcode));
 
-    void parseSystemState(simdjson::ondemand::object json, SystemState& systemState) const
-    {
-        auto& cpuState = systemState.cpuState;
-        cpuState.A     = json["a"].get<std::uint8_t>();
-        cpuState.B     = json["b"].get<std::uint8_t>();
-        cpuState.C     = json["c"].get<std::uint8_t>();
-        cpuState.D     = json["d"].get<std::uint8_t>();
-        cpuState.E     = json["e"].get<std::uint8_t>();
-        cpuState.F     = json["f"].get<std::uint8_t>();
-        cpuState.H     = json["h"].get<std::uint8_t>();
-        cpuState.L     = json["l"].get<std::uint8_t>();
-        cpuState.PC    = json["pc"].get<std::uint16_t>();
-        cpuState.SP    = json["sp"].get<std::uint16_t>();
-
-        auto& ram = systemState.ram;
-
-        ram.clear();
-        for (simdjson::ondemand::array slotJson : json["ram"])
+        // Prefer the packed corpus written by pack_single_step_tests, fall back to parsing the json files
+        auto const corpusPath = (Config::SINGLE_STEP_TESTS_DIR / Corpus::filenameFromOpcode(opcode, ".bin"));
+        if (std::filesystem::exists(corpusPath))
         {
-            auto itr   = slotJson.begin();
-            auto& slot = ram.emplace_back();
-            parseNextAs<std::uint16_t>(itr, slot.address);
-            parseNextAs<std::uint8_t>(itr, slot.value);
+            auto const corpus = Corpus::CorpusFile(corpusPath);
+            REQUIRE(corpus.opcode() == opcode);
+
+            for (auto const& test : corpus.records())
+            {
+                runTest(test);
+            }
+            return;
         }
-    }
 
-    template <typename T>
-    void parseCycles(simdjson::ondemand::array json, T& cycles) const
-    {
-        cycles.clear();
-        for (simdjson::ondemand::array cycleJson : json)
+        auto const jsonPath = (Config::SINGLE_STEP_TESTS_DIR / Corpus::filenameFromOpcode(opcode, ".json"));
+
+        simdjson::ondemand::document document;
+        REQUIRE_NOTHROW(document = Corpus::loadJson(jsonPath, parser_, buffer_));
+
+        simdjson::ondemand::array json = document;
+        for (simdjson::ondemand::object testJson : json)
         {
-            auto itr    = cycleJson.begin();
-            auto& cycle = cycles.emplace_back();
-            parseNextAs<std::uint16_t>(itr, cycle.address);
-            parseNextAs<std::uint8_t>(itr, cycle.data);
-            parseNextAs<std::string_view>(itr, cycle.accessMode);
+            REQUIRE_NOTHROW(Corpus::parseRecord(testJson, record_));
+            runTest(record_);
         }
     }
+};
+
+class SingleStepTestInvoker final : public Catch::ITestInvoker
+{
+private:
+    std::uint16_t opcode_;
 
 public:
-    void resetFixtureForOpcode(std::uint16_t opcode) const
+    explicit SingleStepTestInvoker(std::uint16_t opcode) noexcept
+        : opcode_(opcode)
     {
-        setFilepathFromOpcode(opcode);
-        loadFile();
     }
 
-    void loadTestData(simdjson::ondemand::object json) const
+    void invoke() const override
     {
-        testData.name = json["name"];
-        parseSystemState(json["initial"], testData.initial);
-        parseSystemState(json["final"], testData.final);
-        parseCycles(json["cycles"], testData.cycles);
+        SingleStepTestsFixture fixture;
+        fixture.run(opcode_);
     }
 };
-} // namespace
 
-TEST_CASE_PERSISTENT_FIXTURE(SingleStepTestsFixture, "SingleStepTests", "[.][single-step-tests]")
+// One test case per opcode rather than a single loop over every file, so ctest and catch_discover_tests can schedule
+// each opcode on its own
+struct SingleStepTestsRegistrar
 {
-    for (auto opcode : opcodes)
+    SingleStepTestsRegistrar()
     {
-        INFO("opcode: " << ((getUpper(opcode) != 0x00) ? std::format("0x{:04X}", opcode)
-                                                       : std::format("0x{:02X}", getLower(opcode))));
-
-        REQUIRE_NOTHROW(resetFixtureForOpcode(opcode));
-
-        int cycleCount = 0;
-
-        cpu.setOnTickCallback(
-            [this, &cycleCount](Cpu const*)
-            {
-                auto const& lastMemoryAccess = bus.getLastMemoryAccess();
-                auto const& cycle            = testData.cycles.at(cycleCount++);
-
-                if (cycle.accessMode == "r-m")
-                {
-                    REQUIRE(lastMemoryAccess.accessMode == MemoryAccessMode::READ);
-                    REQUIRE(lastMemoryAccess.address == cycle.address);
-                }
-                else if (cycle.accessMode == "-wm")
-                {
-                    REQUIRE(lastMemoryAccess.accessMode == MemoryAccessMode::WRITE);
-                    REQUIRE(lastMemoryAccess.address == cycle.address);
-                    REQUIRE(lastMemoryAccess.data == cycle.data);
-                }
-                else
-                {
-                    // Explicitly ignore checking the last memory access during internal cycles
-                    REQUIRE(cycle.accessMode == "---");
-                }
-            });
-
-        simdjson::ondemand::array json = document;
-        for (simdjson::ondemand::object testJson : json)
+        for (auto opcode : SingleStepTestsFixture::opcodes)
         {
-            REQUIRE_NOTHROW(loadTestData(testJson));
-
-            auto const& initial = testData.initial;
-            auto const& final   = testData.final;
-
-            INFO("test: " << testData.name);
-
-            bus.reset();
-            for (auto const& slot : initial.ram)
-            {
-                bus.write(slot.address, slot.value);
-            }
-
-            cycleCount = 0;
-            cpu.reset(initial.cpuState);
-
-            REQUIRE_NOTHROW(cpu.step());
-
-            REQUIRE(cycleCount == static_cast<int>(testData.cycles.size()));
-
-            REQUIRE(cpu.A() == final.cpuState.A);
-            REQUIRE(cpu.B() == final.cpuState.B);
-            REQUIRE(cpu.C() == final.cpuState.C);
-            REQUIRE(cpu.D() == final.cpuState.D);
-            REQUIRE(cpu.E() == final.cpuState.E);
-            REQUIRE(cpu.F() == final.cpuState.F);
-            REQUIRE(cpu.H() == final.cpuState.H);
-            REQUIRE(cpu.L() == final.cpuState.L);
-            REQUIRE(cpu.SP() == final.cpuState.SP);
-            REQUIRE(cpu.PC() == final.cpuState.PC);
-
-            REQUIRE(cpu.AF() == ((final.cpuState.A << 8) | final.cpuState.F));
-            REQUIRE(cpu.BC() == ((final.cpuState.B << 8) | final.cpuState.C));
-            REQUIRE(cpu.DE() == ((final.cpuState.D << 8) | final.cpuState.E));
-            REQUIRE(cpu.HL() == ((final.cpuState.H << 8) | final.cpuState.L));
-
-            for (auto const& slot : final.ram)
-            {
-                REQUIRE(bus.read(slot.address) == slot.value);
-            }
+            auto const name = std::format("SingleStepTests {}", formatOpcode(opcode));
+            Catch::AutoReg const registration(Catch::Detail::make_unique<SingleStepTestInvoker>(opcode),
+                                              CATCH_INTERNAL_LINEINFO,
+                                              Catch::StringRef(),
+                                              Catch::NameAndTags(name, "[.][single-step-tests]"));
         }
-
-        cpu.setOnTickCallback(nullptr);
     }
-}
\ No newline at end of file
+};
+
+SingleStepTestsRegistrar const registrar;
+} // namespace
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include <fauxboy/frame.hpp>
+#include <fauxboy/terminal_renderer.hpp>
+
+using namespace fxb;
+
+TEST_CASE("Colors map onto the xterm palette", "[terminal_renderer]")
+{
+    REQUIRE(toXterm256(0xFF000000) == 16);
+    REQUIRE(toXterm256(0xFFFFFFFF) == 231);
+    REQUIRE(toXterm256(0xFFFF0000) == 196);
+    REQUIRE(toXterm256(0xFF808080) == 244);
+}
+
+TEST_CASE("Only changed cells are drawn again", "[terminal_renderer]")
+{
+    using namespace std::chrono_literals;
+
+    TerminalRenderer renderer(10ms);
+    auto frame = std::make_unique<HostFramebuffer>();
+    frame->fill(0xFFFFFFFF);
+
+    auto const start = TerminalRenderer::Clock::time_point();
+    std::string output;
+    REQUIRE(renderer.render(*frame, output, start));
+    REQUIRE(output.size() > (TerminalRenderer::COLUMNS * TerminalRenderer::ROWS));
+
+    // Too early
+    output.clear();
+    REQUIRE_FALSE(renderer.render(*frame, output, (start + 5ms)));
+    REQUIRE(output.empty());
+
+    (*frame)[(3 * SCREEN_WIDTH) + 7] = 0xFF000000;
+    REQUIRE(renderer.render(*frame, output, (start + 10ms)));
+    REQUIRE(output == "\x1b[2;8H\x1b[38;5;231;48;5;16m\xE2\x96\x80\x1b[0m");
+
+    output.clear();
+    REQUIRE(renderer.render(*frame, output, (start + 20ms)));
+    REQUIRE(output.empty());
+}
+
+TEST_CASE("Cells of the last palette entry are drawn on a fresh screen", "[terminal_renderer]")
+{
+    // Lands on entry 255 for both halves of every cell
+    REQUIRE(toXterm256(0xFFEFEFEF) == 255);
+
+    TerminalRenderer renderer;
+    auto frame = std::make_unique<HostFramebuffer>();
+    frame->fill(0xFFEFEFEF);
+
+    std::string output;
+    REQUIRE(renderer.render(*frame, output));
+    REQUIRE(output.find("\x1b[38;5;255;48;5;255m") != std::string::npos);
+    REQUIRE(output.find("\xE2\x96\x80") != std::string::npos);
+
+    renderer.invalidate();
+    output.clear();
+    REQUIRE(renderer.render(*frame, output, (TerminalRenderer::Clock::now() + std::chrono::seconds(1))));
+    REQUIRE(output.find("\x1b[38;5;255;48;5;255m") != std::string::npos);
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#ifndef FAUXBOY_TOOLS_LIBRARY_HPP
+#define FAUXBOY_TOOLS_LIBRARY_HPP
+
+#include <filesystem>
+#include <format>
+#include <stdexcept>
+
+#include <dlfcn.h>
+
+#include <fauxboy/abi.hpp>
+
+namespace Tools
+{
+// A build of the library loaded at runtime through its C entry points. Every build gets its own link map so its copy
+// of the emulator symbols never gets interposed by another build, or by the library the tool itself links, even when
+// they share a soname. glibc only has room for a handful of link maps per process
+class Library
+{
+private:
+    void* handle_ = nullptr;
+
+    template <typename T>
+    T* symbol(char const* name) const
+    {
+        auto* address = dlsym(handle_, name);
+        if (address == nullptr)
+        {
+            throw std::runtime_error(std::format("Missing symbol {}: {}", name, dlerror()));
+        }
+        return reinterpret_cast<T*>(address);
+    }
+
+public:
+    std::filesystem::path path;
+
+    decltype(&fxb_abi_version) abiVersion;
+    decltype(&fxb_create) create;
+    decltype(&fxb_destroy) destroy;
+    decltype(&fxb_load) load;
+    decltype(&fxb_save) save;
+    decltype(&fxb_step) step;
+    decltype(&fxb_cycles) cycles;
+    decltype(&fxb_bus_log) busLog;
+
+    decltype(&fxb_game_boy_create) gameBoyCreate;
+    decltype(&fxb_game_boy_destroy) gameBoyDestroy;
+    decltype(&fxb_game_boy_set_buttons) gameBoySetButtons;
+    decltype(&fxb_game_boy_run_frame) gameBoyRunFrame;
+    decltype(&fxb_game_boy_step) gameBoyStep;
+    decltype(&fxb_game_boy_hash) gameBoyHash;
+    decltype(&fxb_game_boy_cycles) gameBoyCycles;
+    decltype(&fxb_game_boy_cpu_state) gameBoyCpuState;
+    decltype(&fxb_game_boy_save) gameBoySave;
+    decltype(&fxb_game_boy_load) gameBoyLoad;
+
+public:
+    explicit Library(std::filesystem::path const& libraryPath)
+        : handle_(dlmopen(LM_ID_NEWLM, libraryPath.c_str(), RTLD_NOW | RTLD_LOCAL)),
+          path(libraryPath)
+    {
+        if (handle_ == nullptr)
+        {
+            throw std::runtime_error(std::format("Could not load {}: {}", libraryPath.c_str(), dlerror()));
+        }
+
+        try
+        {
+            // Checked before anything else so an older build is reported as such instead of as a missing symbol
+            abiVersion = symbol<decltype(fxb_abi_version)>("fxb_abi_version");
+            if (abiVersion() != FXB_ABI_VERSION)
+            {
+                throw std::runtime_error(std::format(
+                    "{} exposes abi version {}, expected {}", libraryPath.c_str(), abiVersion(), FXB_ABI_VERSION));
+            }
+
+            create  = symbol<decltype(fxb_create)>("fxb_create");
+            destroy = symbol<decltype(fxb_destroy)>("fxb_destroy");
+            load    = symbol<decltype(fxb_load)>("fxb_load");
+            save    = symbol<decltype(fxb_save)>("fxb_save");
+            step    = symbol<decltype(fxb_step)>("fxb_step");
+            cycles  = symbol<decltype(fxb_cycles)>("fxb_cycles");
+            busLog  = symbol<decltype(fxb_bus_log)>("fxb_bus_log");
+
+            gameBoyCreate     = symbol<decltype(fxb_game_boy_create)>("fxb_game_boy_create");
+            gameBoyDestroy    = symbol<decltype(fxb_game_boy_destroy)>("fxb_game_boy_destroy");
+            gameBoySetButtons = symbol<decltype(fxb_game_boy_set_buttons)>("fxb_game_boy_set_buttons");
+            gameBoyRunFrame   = symbol<decltype(fxb_game_boy_run_frame)>("fxb_game_boy_run_frame");
+            gameBoyStep       = symbol<decltype(fxb_game_boy_step)>("fxb_game_boy_step");
+            gameBoyHash       = symbol<decltype(fxb_game_boy_hash)>("fxb_game_boy_hash");
+            gameBoyCycles     = symbol<decltype(fxb_game_boy_cycles)>("fxb_game_boy_cycles");
+            gameBoyCpuState   = symbol<decltype(fxb_game_boy_cpu_state)>("fxb_game_boy_cpu_state");
+            gameBoySave       = symbol<decltype(fxb_game_boy_save)>("fxb_game_boy_save");
+            gameBoyLoad       = symbol<decltype(fxb_game_boy_load)>("fxb_game_boy_load");
+        }
+        catch (...)
+        {
+            dlclose(handle_);
+            throw;
+        }
+    }
+
+    Library(Library const&)            = delete;
+    Library& operator=(Library const&) = delete;
+
+    ~Library() { dlclose(handle_); }
+};
+} // namespace Tools
+
+#endif // FAUXBOY_TOOLS_LIBRARY_HPP
\ No newline at end of file
@@ -0,0 +1,123 @@
+#ifndef FAUXBOY_TOOLS_MOVIE_HPP
+#define FAUXBOY_TOOLS_MOVIE_HPP
+
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fauxboy/game_boy.hpp>
+#include <fauxboy/mmu.hpp>
+
+// Recorded input of a rom, read from <rom>.movie next to it when present. One "<frame> <buttons>" line per change where
+// the buttons are joined with '+' (A+B+SELECT+START+RIGHT+LEFT+UP+DOWN) or '-' for none and hold until the next line
+namespace Tools
+{
+// Frame at which the buttons change, sorted by frame
+using Movie = std::vector<std::pair<std::uint64_t, std::uint8_t>>;
+
+[[nodiscard]] inline std::uint8_t parseButtons(std::string_view text)
+{
+    constexpr std::array<std::pair<std::string_view, std::uint8_t>, 8> BUTTONS = {{
+        {"A", fxb::Mmu::BUTTON_A},
+        {"B", fxb::Mmu::BUTTON_B},
+        {"SELECT", fxb::Mmu::BUTTON_SELECT},
+        {"START", fxb::Mmu::BUTTON_START},
+        {"RIGHT", fxb::Mmu::BUTTON_RIGHT},
+        {"LEFT", fxb::Mmu::BUTTON_LEFT},
+        {"UP", fxb::Mmu::BUTTON_UP},
+        {"DOWN", fxb::Mmu::BUTTON_DOWN},
+    }};
+
+    if (text == "-")
+    {
+        return 0;
+    }
+
+    std::uint8_t pressed = 0;
+    for (auto const part : std::views::split(text, '+'))
+    {
+        auto const name = std::string_view(part);
+        auto const it   = std::ranges::find(BUTTONS, name, &std::pair<std::string_view, std::uint8_t>::first);
+        if (it == BUTTONS.end())
+        {
+            throw std::invalid_argument(std::format("Unknown button: {}", name));
+        }
+        pressed |= it->second;
+    }
+    return pressed;
+}
+
+// An empty movie when the rom has none, throws on malformed lines
+[[nodiscard]] inline Movie loadMovie(std::filesystem::path const& rom)
+{
+    auto path = rom;
+    path += ".movie";
+
+    Movie movie;
+    auto ifs = std::ifstream(path);
+    if (!ifs.is_open())
+    {
+        return movie;
+    }
+
+    std::string line;
+    while (std::getline(ifs, line))
+    {
+        if (line.empty() || line.starts_with('#'))
+        {
+            continue;
+        }
+
+        auto const separator = line.find(' ');
+        if (separator == std::string::npos)
+        {
+            throw std::invalid_argument(std::format("Malformed movie line in {}: {}", path.c_str(), line));
+        }
+        movie.emplace_back(std::stoull(line.substr(0, separator)), parseButtons(line.substr(separator + 1)));
+    }
+
+    std::ranges::stable_sort(movie, {}, &Movie::value_type::first);
+    return movie;
+}
+
+// Feeds a movie to a machine frame by frame, call before every runFrame()
+class MoviePlayer
+{
+private:
+    Movie const* movie_;
+    Movie::const_iterator next_;
+    std::uint64_t frame_  = 0;
+    std::uint8_t buttons_ = 0;
+
+public:
+    explicit MoviePlayer(Movie const& movie)
+        : movie_(&movie),
+          next_(movie.begin())
+    {
+    }
+
+    // Buttons held during the next frame, for machines that are not driven through a GameBoy
+    [[nodiscard]] std::uint8_t nextFrame() noexcept
+    {
+        for (; (next_ != movie_->end()) && (next_->first <= frame_); ++next_)
+        {
+            buttons_ = next_->second;
+        }
+        ++frame_;
+        return buttons_;
+    }
+
+    void apply(fxb::GameBoy& gameBoy) { gameBoy.mmu().setButtons(nextFrame()); }
+};
+} // namespace Tools
+
+#endif // FAUXBOY_TOOLS_MOVIE_HPP
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef FAUXBOY_TOOLS_ROM_CORPUS_HPP
+#define FAUXBOY_TOOLS_ROM_CORPUS_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <format>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Shared by the tools that run a whole directory of roms
+namespace Tools
+{
+// Every .gb and .gbc file below the directory in a stable order, throws when there are none
+[[nodiscard]] inline std::vector<std::filesystem::path> findRoms(std::filesystem::path const& directory)
+{
+    std::vector<std::filesystem::path> roms;
+    for (auto const& entry : std::filesystem::recursive_directory_iterator(directory))
+    {
+        auto const extension = entry.path().extension();
+        if (entry.is_regular_file() && ((extension == ".gb") || (extension == ".gbc")))
+        {
+            roms.push_back(entry.path());
+        }
+    }
+    std::ranges::sort(roms);
+
+    if (roms.empty())
+    {
+        throw std::runtime_error(std::format("No roms found in {}", directory.c_str()));
+    }
+    return roms;
+}
+
+[[nodiscard]] inline unsigned defaultJobs() noexcept
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Calls body(index) for every index below count, every worker claims the next index until none are left so slow roms
+// do not hold up a whole share of the corpus, results should land in per index slots so no locking is needed
+template <typename Body>
+void parallelFor(std::size_t count, unsigned jobs, Body const& body)
+{
+    std::atomic<std::size_t> next = 0;
+
+    std::vector<std::jthread> workers;
+    for (unsigned i = 0; i < std::min<std::size_t>(jobs, count); ++i)
+    {
+        workers.emplace_back(
+            [&]
+            {
+                for (auto index = next++; index < count; index = next++)
+                {
+                    body(index);
+                }
+            });
+    }
+}
+} // namespace Tools
+
+#endif // FAUXBOY_TOOLS_ROM_CORPUS_HPP
\ No newline at end of file
@@ -0,0 +1,366 @@
+// Replays a rom and its movie on two builds of the library and pinpoints the first instruction where they diverge
+//
+// usage: fauxboy_bisect <lib_a> <lib_b> <rom> [--frames N]
+//
+// Both builds run the rom frame by frame with the input from <rom>.movie and compare their state hashes after every
+// frame. Inside the first frame that differs the instruction count is binary searched from the snapshots both builds
+// took before it, and the snapshots right after the first diverging instruction are compared byte by byte
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <algorithm>
+#include <concepts>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fauxboy/abi.hpp>
+#include <fauxboy/cpu.hpp>
+#include <fauxboy/game_boy.hpp>
+
+#include "library.hpp"
+#include "movie.hpp"
+
+using namespace fxb;
+
+namespace
+{
+// A frame never takes more instructions than m-cycles, twice that in double speed mode
+constexpr std::uint64_t MAX_FRAME_STEPS = (2 * GameBoy::M_CYCLES_PER_FRAME);
+
+struct Options
+{
+    std::filesystem::path libraryA;
+    std::filesystem::path libraryB;
+    std::filesystem::path rom;
+    std::uint64_t frames = 600;
+};
+
+struct StepResult
+{
+    fxb_status status;
+    std::uint64_t executed;
+
+    [[nodiscard]] bool operator==(StepResult const&) const noexcept = default;
+};
+
+class Machine
+{
+private:
+    Tools::Library const& library_;
+    fxb_game_boy* gameBoy_;
+
+public:
+    Machine(Tools::Library const& library, std::span<std::uint8_t const> rom)
+        : library_(library),
+          gameBoy_(library.gameBoyCreate(rom.data(), rom.size()))
+    {
+        if (gameBoy_ == nullptr)
+        {
+            throw std::runtime_error(std::format("{} could not create a machine for the rom", library.path.c_str()));
+        }
+    }
+
+    Machine(Machine const&)            = delete;
+    Machine& operator=(Machine const&) = delete;
+
+    ~Machine() { library_.gameBoyDestroy(gameBoy_); }
+
+    void setButtons(std::uint8_t pressed) { library_.gameBoySetButtons(gameBoy_, pressed); }
+
+    [[nodiscard]] fxb_status runFrame() { return library_.gameBoyRunFrame(gameBoy_); }
+
+    StepResult step(std::uint64_t count)
+    {
+        StepResult result;
+        result.status = library_.gameBoyStep(gameBoy_, count, &result.executed);
+        return result;
+    }
+
+    [[nodiscard]] std::uint64_t hash() const { return library_.gameBoyHash(gameBoy_); }
+    [[nodiscard]] std::uint64_t cycles() const { return library_.gameBoyCycles(gameBoy_); }
+
+    [[nodiscard]] CpuState cpuState() const
+    {
+        CpuState state;
+        library_.gameBoyCpuState(gameBoy_, &state);
+        return state;
+    }
+
+    [[nodiscard]] std::vector<std::uint8_t> save() const
+    {
+        std::vector<std::uint8_t> snapshot(library_.gameBoySave(gameBoy_, nullptr, 0));
+        if (snapshot.empty() || (library_.gameBoySave(gameBoy_, snapshot.data(), snapshot.size()) != snapshot.size()))
+        {
+            throw std::runtime_error(std::format("{} could not save a snapshot", library_.path.c_str()));
+        }
+        return snapshot;
+    }
+
+    void load(std::span<std::uint8_t const> snapshot)
+    {
+        if (library_.gameBoyLoad(gameBoy_, snapshot.data(), snapshot.size()) != FXB_OK)
+        {
+            throw std::runtime_error(std::format("{} rejected its own snapshot", library_.path.c_str()));
+        }
+    }
+};
+
+// Each build only ever loads snapshots it took itself, the two builds are free to lay them out differently
+struct Checkpoint
+{
+    std::vector<std::uint8_t> a;
+    std::vector<std::uint8_t> b;
+};
+
+struct Pair
+{
+    Machine a;
+    Machine b;
+
+    [[nodiscard]] bool agree() const { return (a.hash() == b.hash()); }
+
+    // Runs both machines from the checkpoint, returns true while they still agree
+    bool agreeAfter(Checkpoint const& from, std::uint64_t count)
+    {
+        a.load(from.a);
+        b.load(from.b);
+        return ((a.step(count) == b.step(count)) && agree());
+    }
+};
+
+Options parseOptions(int argc, char* argv[])
+{
+    Options options;
+    std::vector<std::string_view> positional;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view const arg = argv[i];
+
+        auto const nextValue = [&]
+        {
+            if ((i + 1) >= argc)
+            {
+                throw std::invalid_argument(std::format("Missing value for {}", arg));
+            }
+            return std::string(argv[++i]);
+        };
+
+        if (arg == "--frames")
+        {
+            options.frames = std::stoull(nextValue());
+        }
+        else
+        {
+            positional.push_back(arg);
+        }
+    }
+
+    if (positional.size() != 3)
+    {
+        throw std::invalid_argument("usage: fauxboy_bisect <lib_a> <lib_b> <rom> [--frames N]");
+    }
+
+    options.libraryA = positional[0];
+    options.libraryB = positional[1];
+    options.rom      = positional[2];
+    return options;
+}
+
+std::vector<std::uint8_t> readRom(std::filesystem::path const& path)
+{
+    auto ifs = std::ifstream(path, std::ios::binary);
+    if (!ifs.is_open())
+    {
+        throw std::runtime_error(std::format("Could not open file: {}", path.c_str()));
+    }
+    return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(ifs), {});
+}
+
+void printRegisters(CpuState const& a, CpuState const& b)
+{
+    auto const printRegister = []<std::unsigned_integral T>(std::string_view name, T lhs, T rhs)
+    {
+        auto const hex = [](T value)
+        {
+            return ((sizeof(T) == 1) ? std::format("{:02X}", value) : std::format("{:04X}", value));
+        };
+        std::cout << std::format("  {:<2} {} {}{}\n", name, hex(lhs), hex(rhs), ((lhs != rhs) ? "  <--" : ""));
+    };
+
+    std::cout << "registers (a b)\n";
+    printRegister("A", a.A, b.A);
+    printRegister("F", a.F, b.F);
+    printRegister("B", a.B, b.B);
+    printRegister("C", a.C, b.C);
+    printRegister("D", a.D, b.D);
+    printRegister("E", a.E, b.E);
+    printRegister("H", a.H, b.H);
+    printRegister("L", a.L, b.L);
+    printRegister("SP", a.SP, b.SP);
+    printRegister("PC", a.PC, b.PC);
+}
+
+// Offsets into the snapshots, which start with the registers and the cycle counter followed by the memory map
+void printSnapshotDiff(std::span<std::uint8_t const> before,
+                       std::span<std::uint8_t const> a,
+                       std::span<std::uint8_t const> b)
+{
+    constexpr int MAX_SNAPSHOT_DIFFS = 32;
+
+    if (a.size() != b.size())
+    {
+        std::cout << std::format("snapshots are {} and {} bytes long\n", a.size(), b.size());
+    }
+
+    auto const byteAt = [](std::span<std::uint8_t const> snapshot, std::size_t offset)
+    {
+        return ((offset < snapshot.size()) ? std::format("{:02X}", snapshot[offset]) : std::string("--"));
+    };
+
+    int diffCount = 0;
+    std::cout << "snapshot (offset before a b)\n";
+    for (std::size_t offset = 0; offset < std::max(a.size(), b.size()); ++offset)
+    {
+        if ((offset < a.size()) && (offset < b.size()) && (a[offset] == b[offset]))
+        {
+            continue;
+        }
+
+        if (diffCount++ < MAX_SNAPSHOT_DIFFS)
+        {
+            std::cout << std::format(
+                "  0x{:06X} {} {} {}\n", offset, byteAt(before, offset), byteAt(a, offset), byteAt(b, offset));
+        }
+    }
+
+    if (diffCount > MAX_SNAPSHOT_DIFFS)
+    {
+        std::cout << std::format("  ... {} more\n", (diffCount - MAX_SNAPSHOT_DIFFS));
+    }
+}
+
+int bisect(Options const& options)
+{
+    auto const libraryA = Tools::Library(options.libraryA);
+    auto const libraryB = Tools::Library(options.libraryB);
+
+    auto const rom   = readRom(options.rom);
+    auto const movie = Tools::loadMovie(options.rom);
+
+    auto pair   = Pair{.a = Machine(libraryA, rom), .b = Machine(libraryB, rom)};
+    auto player = Tools::MoviePlayer(movie);
+
+    if (!pair.agree())
+    {
+        throw std::runtime_error("The builds disagree at power on, their snapshots are not comparable");
+    }
+
+    // Coarse pass, compare hashes after every frame and keep the snapshots from before it
+    Checkpoint checkpoint;
+    std::uint8_t buttons = 0;
+    std::uint64_t frame  = 0;
+    for (; frame < options.frames; ++frame)
+    {
+        buttons = player.nextFrame();
+        pair.a.setButtons(buttons);
+        pair.b.setButtons(buttons);
+        checkpoint = {.a = pair.a.save(), .b = pair.b.save()};
+
+        auto const statusA = pair.a.runFrame();
+        auto const statusB = pair.b.runFrame();
+        if ((statusA != statusB) || !pair.agree())
+        {
+            break;
+        }
+
+        if (statusA != FXB_OK)
+        {
+            std::cout << std::format(
+                "both builds stopped with status {} in frame {}\n", static_cast<int>(statusA), frame);
+            return EXIT_SUCCESS;
+        }
+    }
+
+    if (frame == options.frames)
+    {
+        std::cout << std::format("no divergence after {} frames, hash 0x{:016X}\n", frame, pair.a.hash());
+        return EXIT_SUCCESS;
+    }
+
+    // Fine pass, binary search the instructions of the frame, runs always restart from the checkpoint before it
+    if (pair.agreeAfter(checkpoint, MAX_FRAME_STEPS))
+    {
+        std::cout << std::format("frame {} diverges but stepping through it does not, the builds agree again after "
+                                 "{} instructions\n",
+                                 frame,
+                                 MAX_FRAME_STEPS);
+        return EXIT_FAILURE;
+    }
+
+    std::uint64_t lo = 0;
+    std::uint64_t hi = MAX_FRAME_STEPS;
+    while ((hi - lo) > 1)
+    {
+        auto const mid = (lo + ((hi - lo) / 2));
+        if (pair.agreeAfter(checkpoint, mid))
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    pair.agreeAfter(checkpoint, lo);
+    auto const before       = pair.a.save();
+    auto const beforeState  = pair.a.cpuState();
+    auto const cyclesBefore = pair.a.cycles();
+
+    auto const resultA = pair.a.step(1);
+    auto const resultB = pair.b.step(1);
+
+    std::cout << std::format("divergence in frame {} after {} agreeing instructions of that frame\n", frame, lo);
+    std::cout << std::format("  a: {}\n  b: {}\n", options.libraryA.c_str(), options.libraryB.c_str());
+    std::cout << std::format(
+        "first diverging instruction at PC=0x{:04X} with buttons {:02X}\n", beforeState.PC, buttons);
+
+    if (resultA != resultB)
+    {
+        std::cout << std::format(
+            "status (a b)\n  {} {}\n", static_cast<int>(resultA.status), static_cast<int>(resultB.status));
+    }
+
+    printRegisters(pair.a.cpuState(), pair.b.cpuState());
+
+    auto const cyclesA = (pair.a.cycles() - cyclesBefore);
+    auto const cyclesB = (pair.b.cycles() - cyclesBefore);
+    std::cout << std::format("m-cycles (a b)\n  {} {}{}\n", cyclesA, cyclesB, ((cyclesA != cyclesB) ? "  <--" : ""));
+
+    printSnapshotDiff(before, pair.a.save(), pair.b.save());
+    return EXIT_FAILURE;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        return bisect(parseOptions(argc, argv));
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << '\n';
+        return 2;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,218 @@
+// Runs every rom of a corpus twice at once on two threads with its recorded input and compares a hash of the whole
+// machine after every frame, reporting the first frame at which the two runs disagree. Anything that makes emulation
+// depend on timing, uninitialised memory or shared state between instances shows up here
+//
+// usage: fauxboy_determinism <rom_or_dir> [--frames N] [--jobs N]
+//
+// A rom picks up its input from <rom>.movie next to it when present, see movie.hpp for the format
+
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fauxboy/cartridge.hpp>
+#include <fauxboy/game_boy.hpp>
+
+#include "movie.hpp"
+#include "rom_corpus.hpp"
+
+using namespace fxb;
+
+namespace
+{
+struct Options
+{
+    std::filesystem::path roms;
+    std::uint64_t frames = 600;
+    unsigned jobs        = std::max(1u, (Tools::defaultJobs() / 2));
+};
+
+struct Divergence
+{
+    // Counted from 1, the hashes are taken after that frame ran
+    std::uint64_t frame = 0;
+    std::uint64_t lhs   = 0;
+    std::uint64_t rhs   = 0;
+};
+
+struct Result
+{
+    std::optional<Divergence> divergence;
+    std::string error;
+};
+
+// Hash of the machine at the end of every frame
+std::vector<std::uint64_t> runMovie(std::filesystem::path const& path, Tools::Movie const& movie, std::uint64_t frames)
+{
+    GameBoy gameBoy(Cartridge::load(path));
+    Tools::MoviePlayer player(movie);
+
+    std::vector<std::uint64_t> hashes;
+    hashes.reserve(frames);
+    for (std::uint64_t frame = 0; frame < frames; ++frame)
+    {
+        player.apply(gameBoy);
+        gameBoy.runFrame();
+        hashes.push_back(gameBoy.hash());
+    }
+    return hashes;
+}
+
+Result check(std::filesystem::path const& path, std::uint64_t frames)
+{
+    Result result;
+
+    try
+    {
+        auto const movie = Tools::loadMovie(path);
+
+        std::vector<std::uint64_t> lhs;
+        std::vector<std::uint64_t> rhs;
+        std::string lhsError;
+        std::string rhsError;
+
+        // Both runs are in flight together so they race for caches, the allocator and anything else they might share
+        auto const run = [&path, &movie, frames](std::vector<std::uint64_t>& hashes, std::string& error)
+        {
+            try
+            {
+                hashes = runMovie(path, movie, frames);
+            }
+            catch (std::exception const& e)
+            {
+                error = e.what();
+            }
+        };
+        {
+            auto lhsThread = std::jthread(run, std::ref(lhs), std::ref(lhsError));
+            auto rhsThread = std::jthread(run, std::ref(rhs), std::ref(rhsError));
+        }
+
+        if (!lhsError.empty() || !rhsError.empty())
+        {
+            result.error = (lhsError.empty() ? rhsError : lhsError);
+            return result;
+        }
+
+        auto const [lhsEnd, rhsEnd] = std::ranges::mismatch(lhs, rhs);
+        if (lhsEnd != lhs.end())
+        {
+            result.divergence = Divergence{.frame = static_cast<std::uint64_t>(lhsEnd - lhs.begin()) + 1,
+                                           .lhs   = *lhsEnd,
+                                           .rhs   = *rhsEnd};
+        }
+    }
+    catch (std::exception const& e)
+    {
+        result.error = e.what();
+    }
+    return result;
+}
+
+Options parseOptions(int argc, char* argv[])
+{
+    Options options;
+    std::vector<std::string_view> positional;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view const arg = argv[i];
+
+        auto const nextValue = [&]
+        {
+            if ((i + 1) >= argc)
+            {
+                throw std::invalid_argument(std::format("Missing value for {}", arg));
+            }
+            return std::string(argv[++i]);
+        };
+
+        if (arg == "--frames")
+        {
+            options.frames = std::stoull(nextValue());
+        }
+        else if (arg == "--jobs")
+        {
+            options.jobs = std::max(1u, static_cast<unsigned>(std::stoul(nextValue())));
+        }
+        else
+        {
+            positional.push_back(arg);
+        }
+    }
+
+    if ((positional.size() != 1) || (options.frames == 0))
+    {
+        throw std::invalid_argument("usage: fauxboy_determinism <rom_or_dir> [--frames N] [--jobs N]");
+    }
+    options.roms = positional[0];
+    return options;
+}
+
+int runAll(Options const& options)
+{
+    auto const roms = (std::filesystem::is_directory(options.roms) ? Tools::findRoms(options.roms)
+                                                                    : std::vector{options.roms});
+
+    // Every job runs two threads of its own
+    std::vector<Result> results(roms.size());
+    Tools::parallelFor(
+        roms.size(), options.jobs, [&](std::size_t index) { results[index] = check(roms[index], options.frames); });
+
+    std::size_t failed = 0;
+    for (std::size_t i = 0; i < roms.size(); ++i)
+    {
+        auto const name    = roms[i].filename().string();
+        auto const& result = results[i];
+
+        if (!result.error.empty())
+        {
+            ++failed;
+            std::cout << std::format("{:<10}{}  {}\n", "ERROR", name, result.error);
+        }
+        else if (result.divergence)
+        {
+            ++failed;
+            std::cout << std::format("{:<10}{}  first diverging frame {}: {:016x} != {:016x}\n",
+                                     "DIVERGED",
+                                     name,
+                                     result.divergence->frame,
+                                     result.divergence->lhs,
+                                     result.divergence->rhs);
+        }
+        else
+        {
+            std::cout << std::format("{:<10}{}\n", "OK", name);
+        }
+    }
+
+    std::cout << std::format("\n{}/{} roms deterministic over {} frames\n",
+                             (roms.size() - failed),
+                             roms.size(),
+                             options.frames);
+    return ((failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        return runAll(parseOptions(argc, argv));
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << '\n';
+        return 2;
+    }
+}
\ No newline at end of file
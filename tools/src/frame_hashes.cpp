@@ -0,0 +1,293 @@
+// Runs every rom of a corpus with its recorded input and compares hashes of the picture at chosen frames against a
+// golden file, any optimisation that changes what ends up on screen shows up as a mismatch
+//
+// usage: fauxboy_frame_hashes <rom_dir> --golden <file> [--frames N,N,...] [--update] [--jobs N]
+//
+// A rom picks up its input from <rom>.movie next to it when present, see movie.hpp for the format
+//
+// The golden file holds one "<rom> <frame> <hash>" line per captured frame, --update rewrites it from the current run
+
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fauxboy/address.hpp>
+#include <fauxboy/cartridge.hpp>
+#include <fauxboy/game_boy.hpp>
+#include <fauxboy/hash.hpp>
+#include <fauxboy/mmu.hpp>
+
+#include "movie.hpp"
+#include "rom_corpus.hpp"
+
+using namespace fxb;
+
+namespace
+{
+struct Options
+{
+    std::filesystem::path romDir;
+    std::filesystem::path golden;
+    std::vector<std::uint64_t> frames = {60, 300, 900};
+    bool update                       = false;
+    unsigned jobs                     = Tools::defaultJobs();
+};
+
+// Hash per captured frame, keyed by rom and frame
+using Hashes = std::map<std::pair<std::string, std::uint64_t>, std::uint64_t>;
+
+struct Capture
+{
+    std::vector<std::uint64_t> hashes;
+    std::string error;
+};
+
+// There is no PPU yet, so the hash covers everything the picture is drawn from: tile data and maps, sprites, scroll,
+// window and palette registers
+std::uint64_t hashFrame(GameBoy& gameBoy)
+{
+    // LCDC, SCY, SCX, BGP, OBP0, OBP1, WY, WX
+    constexpr std::array<std::uint16_t, 8> LCD_REGISTERS = {
+        0xFF40, 0xFF42, 0xFF43, 0xFF47, 0xFF48, 0xFF49, 0xFF4A, 0xFF4B};
+
+    auto& mmu = gameBoy.mmu();
+
+    std::array<std::uint8_t, LCD_REGISTERS.size()> registers;
+    std::ranges::transform(
+        LCD_REGISTERS, registers.begin(), [&mmu](std::uint16_t address) { return mmu.read(Address(address)); });
+
+    return hashBytes(mmu.vram(), hashBytes(mmu.oam(), hashBytes(registers)));
+}
+
+Capture capture(std::filesystem::path const& path, std::vector<std::uint64_t> const& frames)
+{
+    Capture result;
+
+    try
+    {
+        auto const movie = Tools::loadMovie(path);
+        GameBoy gameBoy(Cartridge::load(path));
+
+        Tools::MoviePlayer player(movie);
+        for (std::uint64_t frame = 0; frame < frames.back(); ++frame)
+        {
+            player.apply(gameBoy);
+            gameBoy.runFrame();
+
+            if (std::ranges::binary_search(frames, (frame + 1)))
+            {
+                result.hashes.push_back(hashFrame(gameBoy));
+            }
+        }
+    }
+    catch (std::exception const& e)
+    {
+        result.error = e.what();
+    }
+    return result;
+}
+
+Hashes loadGolden(std::filesystem::path const& path)
+{
+    Hashes golden;
+    auto ifs = std::ifstream(path);
+    if (!ifs.is_open())
+    {
+        return golden;
+    }
+
+    // Rom names may contain spaces, the frame and hash are the last two fields
+    std::string line;
+    while (std::getline(ifs, line))
+    {
+        auto const hashStart  = line.rfind(' ');
+        auto const frameStart = ((hashStart == std::string::npos) ? hashStart : line.rfind(' ', (hashStart - 1)));
+        if ((frameStart == std::string::npos) || (frameStart == 0))
+        {
+            throw std::invalid_argument(std::format("Malformed golden line in {}: {}", path.c_str(), line));
+        }
+
+        auto const frame = std::stoull(line.substr(frameStart + 1, (hashStart - frameStart - 1)));
+        golden[{line.substr(0, frameStart), frame}] = std::stoull(line.substr(hashStart + 1), nullptr, 16);
+    }
+    return golden;
+}
+
+void saveGolden(std::filesystem::path const& path, Hashes const& hashes)
+{
+    auto ofs = std::ofstream(path);
+    if (!ofs.is_open())
+    {
+        throw std::runtime_error(std::format("Could not open file: {}", path.c_str()));
+    }
+
+    for (auto const& [key, hash] : hashes)
+    {
+        ofs << std::format("{} {} {:016x}\n", key.first, key.second, hash);
+    }
+}
+
+std::vector<std::uint64_t> parseFrames(std::string_view text)
+{
+    std::vector<std::uint64_t> frames;
+    for (auto const part : std::views::split(text, ','))
+    {
+        auto const frame = std::stoull(std::string(std::string_view(part)));
+        if (frame == 0)
+        {
+            throw std::invalid_argument("Frames are counted from 1");
+        }
+        frames.push_back(frame);
+    }
+
+    std::ranges::sort(frames);
+    auto const duplicates = std::ranges::unique(frames);
+    frames.erase(duplicates.begin(), duplicates.end());
+    return frames;
+}
+
+Options parseOptions(int argc, char* argv[])
+{
+    Options options;
+    std::vector<std::string_view> positional;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view const arg = argv[i];
+
+        auto const nextValue = [&]
+        {
+            if ((i + 1) >= argc)
+            {
+                throw std::invalid_argument(std::format("Missing value for {}", arg));
+            }
+            return std::string_view(argv[++i]);
+        };
+
+        if (arg == "--golden")
+        {
+            options.golden = nextValue();
+        }
+        else if (arg == "--frames")
+        {
+            options.frames = parseFrames(nextValue());
+        }
+        else if (arg == "--update")
+        {
+            options.update = true;
+        }
+        else if (arg == "--jobs")
+        {
+            options.jobs = std::max(1u, static_cast<unsigned>(std::stoul(std::string(nextValue()))));
+        }
+        else
+        {
+            positional.push_back(arg);
+        }
+    }
+
+    if ((positional.size() != 1) || options.golden.empty() || options.frames.empty())
+    {
+        throw std::invalid_argument(
+            "usage: fauxboy_frame_hashes <rom_dir> --golden <file> [--frames N,N,...] [--update] [--jobs N]");
+    }
+    options.romDir = positional[0];
+    return options;
+}
+
+int runAll(Options const& options)
+{
+    auto const roms = Tools::findRoms(options.romDir);
+
+    std::vector<Capture> captures(roms.size());
+    Tools::parallelFor(
+        roms.size(), options.jobs, [&](std::size_t index) { captures[index] = capture(roms[index], options.frames); });
+
+    auto golden = loadGolden(options.golden);
+    Hashes current;
+
+    std::size_t failed  = 0;
+    std::size_t errors  = 0;
+    std::size_t missing = 0;
+    for (std::size_t i = 0; i < roms.size(); ++i)
+    {
+        auto const name     = std::filesystem::relative(roms[i], options.romDir).string();
+        auto const& capture = captures[i];
+
+        if (!capture.error.empty())
+        {
+            ++errors;
+            std::cout << std::format("{:<10}{}  {}\n", "ERROR", name, capture.error);
+            continue;
+        }
+
+        std::string_view verdict = "OK";
+        std::string detail;
+        for (std::size_t j = 0; j < options.frames.size(); ++j)
+        {
+            auto const key  = std::pair(name, options.frames[j]);
+            auto const hash = capture.hashes[j];
+            current[key]    = hash;
+
+            auto const expected = golden.find(key);
+            if (expected == golden.end())
+            {
+                verdict = ((verdict == "OK") ? "NEW" : verdict);
+            }
+            else if ((expected->second != hash) && detail.empty())
+            {
+                verdict = "MISMATCH";
+                detail  = std::format("frame {}: {:016x} != {:016x}", key.second, hash, expected->second);
+            }
+            golden.erase(key);
+        }
+
+        failed += (verdict != "OK");
+        std::cout << std::format("{:<10}{}  {}\n", verdict, name, detail);
+    }
+
+    // Whatever is left was captured at a frame or for a rom that is not part of this run
+    for (auto const& [key, hash] : golden)
+    {
+        ++missing;
+        std::cout << std::format("{:<10}{}  frame {}\n", "MISSING", key.first, key.second);
+    }
+
+    // Roms that failed to run keep no hashes, refuse to drop them from the golden file
+    if (options.update && (errors == 0))
+    {
+        saveGolden(options.golden, current);
+        std::cout << std::format("\nWrote {} hashes to {}\n", current.size(), options.golden.c_str());
+        return EXIT_SUCCESS;
+    }
+
+    std::cout << std::format("\n{}/{} roms match", (roms.size() - failed - errors), roms.size());
+    std::cout << ((missing != 0) ? std::format(", {} golden hashes missing\n", missing) : "\n");
+    return (((failed + errors + missing) == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        return runAll(parseOptions(argc, argv));
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << '\n';
+        return 2;
+    }
+}
\ No newline at end of file
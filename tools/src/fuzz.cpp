@@ -0,0 +1,499 @@
+// Differential fuzzer, runs random instruction streams on random memory images through every backend and compares the
+// registers, memory and what each instruction did on the bus during every m-cycle against the reference interpreter
+//
+// usage: fauxboy_fuzz [--backend <lib>]... [--iterations N] [--seed N] [--size N] [<input>...]
+//
+// Backends are builds of the library loaded through the C entry points, each is checked against the Cpu this tool is
+// linked with. Inputs given on the command line are replayed instead of generating new ones, a mismatching input is
+// written to mismatch-<hash>.bin so it can be replayed the same way
+//
+// Built with -fsanitize=fuzzer the same harness becomes a libFuzzer target, the backends are then taken from the
+// colon separated FAUXBOY_FUZZ_BACKENDS environment variable
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fauxboy/abi.hpp>
+#include <fauxboy/cpu.hpp>
+#include <fauxboy/hash.hpp>
+#include <fauxboy/recording_bus.hpp>
+
+#include "library.hpp"
+
+using namespace fxb;
+
+namespace
+{
+// Registers, the step count and the first bytes of the instruction stream
+constexpr std::size_t HEADER_SIZE = 13;
+constexpr std::uint64_t MAX_STEPS = 64;
+
+struct Options
+{
+    std::vector<std::filesystem::path> backends;
+    std::vector<std::filesystem::path> inputs;
+    std::uint64_t iterations = 100'000;
+    std::uint64_t seed       = std::random_device()();
+    std::size_t size         = 256;
+};
+
+struct Case
+{
+    CpuState state;
+    std::vector<std::uint8_t> memory = std::vector<std::uint8_t>(FXB_MEMORY_SIZE, 0);
+    std::uint64_t steps              = 0;
+};
+
+struct Run
+{
+    fxb_status status      = FXB_OK;
+    std::uint64_t executed = 0;
+    CpuState state;
+    std::vector<std::uint8_t> memory = std::vector<std::uint8_t>(FXB_MEMORY_SIZE, 0);
+    // M-cycles taken by each executed instruction
+    std::vector<std::size_t> cycleCounts;
+    // The bus log of every executed instruction back to back, at most RecordingBus::MAX_CYCLES entries each
+    std::vector<BusCycle> busLog;
+
+    void record(std::size_t cycleCount, std::span<BusCycle const> log)
+    {
+        cycleCounts.push_back(cycleCount);
+        busLog.insert(busLog.end(), log.begin(), log.end());
+    }
+};
+
+class Backend
+{
+public:
+    virtual ~Backend() = default;
+
+    [[nodiscard]] virtual std::string name() const = 0;
+    [[nodiscard]] virtual Run run(Case const& input) = 0;
+};
+
+// The switch interpreter this tool is linked with, everything else is measured against it
+class ReferenceBackend final : public Backend
+{
+private:
+    RecordingBus bus_;
+    Cpu cpu_ = Cpu(&bus_);
+
+public:
+    ReferenceBackend()
+    {
+        cpu_.setOnTickCallback([this](Cpu*) { bus_.endCycle(); });
+    }
+
+    [[nodiscard]] std::string name() const override { return "reference"; }
+
+    [[nodiscard]] Run run(Case const& input) override
+    {
+        std::ranges::copy(input.memory, bus_.memory().begin());
+        cpu_.reset(input.state);
+
+        Run result;
+        for (; result.executed < input.steps; ++result.executed)
+        {
+            bus_.clearLog();
+            try
+            {
+                cpu_.step();
+            }
+            catch (IllegalOpcodeException const&)
+            {
+                result.status = FXB_ILLEGAL_OPCODE;
+                break;
+            }
+            catch (...)
+            {
+                result.status = FXB_ERROR;
+                break;
+            }
+            result.record(bus_.cycleCount(), bus_.log());
+        }
+
+        result.state = cpu_.state();
+        std::ranges::copy(bus_.memory(), result.memory.begin());
+        return result;
+    }
+};
+
+// Steps one instruction at a time so the bus log of each can be read back
+class LibraryBackend final : public Backend
+{
+private:
+    Tools::Library library_;
+    fxb_machine* machine_;
+
+public:
+    explicit LibraryBackend(std::filesystem::path const& path)
+        : library_(path),
+          machine_(library_.create())
+    {
+        if (machine_ == nullptr)
+        {
+            throw std::runtime_error(std::format("Could not create a machine from {}", path.c_str()));
+        }
+    }
+
+    LibraryBackend(LibraryBackend const&)            = delete;
+    LibraryBackend& operator=(LibraryBackend const&) = delete;
+
+    ~LibraryBackend() override { library_.destroy(machine_); }
+
+    [[nodiscard]] std::string name() const override { return library_.path.string(); }
+
+    [[nodiscard]] Run run(Case const& input) override
+    {
+        library_.load(machine_, &input.state, input.memory.data());
+
+        Run result;
+        std::array<BusCycle, RecordingBus::MAX_CYCLES> log = {};
+        while ((result.executed < input.steps) && (result.status == FXB_OK))
+        {
+            std::uint64_t executed = 0;
+            result.status          = library_.step(machine_, 1, &executed);
+            result.executed += executed;
+
+            if (executed != 0)
+            {
+                auto const cycleCount = library_.busLog(machine_, log.data(), log.size());
+                result.record(cycleCount, std::span(log).first(std::min(cycleCount, log.size())));
+            }
+        }
+
+        library_.save(machine_, &result.state, result.memory.data());
+        return result;
+    }
+};
+
+// The reference always comes first
+std::vector<std::unique_ptr<Backend>> makeBackends(std::span<std::filesystem::path const> libraries)
+{
+    std::vector<std::unique_ptr<Backend>> backends;
+    backends.push_back(std::make_unique<ReferenceBackend>());
+    for (auto const& library : libraries)
+    {
+        backends.push_back(std::make_unique<LibraryBackend>(library));
+    }
+    return backends;
+}
+
+// The first bytes of the input become the registers and the step count, the rest is the instruction stream placed at
+// PC. Memory outside of the stream is filled from a generator seeded with the input so every input maps to exactly
+// one memory image
+Case decode(std::span<std::uint8_t const> data)
+{
+    Case result;
+
+    std::array<std::uint8_t, HEADER_SIZE> header = {};
+    std::ranges::copy(data.first(std::min(data.size(), HEADER_SIZE)), header.begin());
+
+    result.state = {
+        .A  = header[0],
+        .B  = header[1],
+        .C  = header[2],
+        .D  = header[3],
+        .E  = header[4],
+        .F  = static_cast<std::uint8_t>(header[5] & 0xF0),
+        .H  = header[6],
+        .L  = header[7],
+        .SP = static_cast<std::uint16_t>(header[8] | (header[9] << 8)),
+        .PC = static_cast<std::uint16_t>(header[10] | (header[11] << 8)),
+    };
+    result.steps = ((header[12] % MAX_STEPS) + 1);
+
+    auto generator = std::mt19937_64(hashBytes(data));
+    for (std::size_t i = 0; i < result.memory.size(); i += sizeof(std::uint64_t))
+    {
+        auto const word = generator();
+        std::memcpy(&result.memory[i], &word, sizeof(word));
+    }
+
+    auto const stream = data.subspan(std::min(data.size(), HEADER_SIZE));
+    for (std::size_t i = 0; i < std::min<std::size_t>(stream.size(), FXB_MEMORY_SIZE); ++i)
+    {
+        result.memory[static_cast<std::uint16_t>(result.state.PC + i)] = stream[i];
+    }
+    return result;
+}
+
+std::string describe(CpuState const& state)
+{
+    return std::format("A={:02X} F={:02X} B={:02X} C={:02X} D={:02X} E={:02X} H={:02X} L={:02X} SP={:04X} PC={:04X}",
+                       state.A,
+                       state.F,
+                       state.B,
+                       state.C,
+                       state.D,
+                       state.E,
+                       state.H,
+                       state.L,
+                       state.SP,
+                       state.PC);
+}
+
+std::string describe(BusCycle const& cycle)
+{
+    switch (cycle.activity)
+    {
+        case BusActivity::READ:
+            return std::format("read {:02X} from 0x{:04X}", cycle.data, cycle.address.value);
+        case BusActivity::WRITE:
+            return std::format("write {:02X} to 0x{:04X}", cycle.data, cycle.address.value);
+        case BusActivity::IDLE:
+            break;
+    }
+    return "idle";
+}
+
+// Empty when both runs agree
+std::string compare(Run const& expected, Run const& actual)
+{
+    if ((expected.status != actual.status) || (expected.executed != actual.executed))
+    {
+        return std::format("status {} after {} instructions, expected status {} after {}",
+                           static_cast<int>(actual.status),
+                           actual.executed,
+                           static_cast<int>(expected.status),
+                           expected.executed);
+    }
+
+    if (actual.cycleCounts != expected.cycleCounts)
+    {
+        auto const [e, a] = std::ranges::mismatch(expected.cycleCounts, actual.cycleCounts);
+        auto const index  = std::distance(expected.cycleCounts.begin(), e);
+        return std::format("instruction {} took {} m-cycles, expected {}", index, *a, *e);
+    }
+
+    // Both logs have the same shape once the counts agree, the index is mapped back to an instruction and its m-cycle
+    if (auto const [e, a] = std::ranges::mismatch(expected.busLog, actual.busLog); e != expected.busLog.end())
+    {
+        auto cycle              = static_cast<std::size_t>(std::distance(expected.busLog.begin(), e));
+        std::size_t instruction = 0;
+        for (auto const count : expected.cycleCounts)
+        {
+            auto const recorded = std::min(count, RecordingBus::MAX_CYCLES);
+            if (cycle < recorded)
+            {
+                break;
+            }
+            cycle -= recorded;
+            ++instruction;
+        }
+        return std::format(
+            "instruction {} m-cycle {}: {}, expected {}", instruction, cycle, describe(*a), describe(*e));
+    }
+
+    if (hashState(actual.state) != hashState(expected.state))
+    {
+        return std::format("registers {}\n  expected  {}", describe(actual.state), describe(expected.state));
+    }
+
+    auto const [e, a] = std::ranges::mismatch(expected.memory, actual.memory);
+    if (e != expected.memory.end())
+    {
+        auto const address = std::distance(expected.memory.begin(), e);
+        return std::format("memory at 0x{:04X} is {:02X}, expected {:02X}", address, *a, *e);
+    }
+    return {};
+}
+
+// Returns the first mismatch, empty when every backend agrees with the reference
+std::string check(std::span<std::unique_ptr<Backend> const> backends, std::span<std::uint8_t const> data)
+{
+    auto const input    = decode(data);
+    auto const expected = backends.front()->run(input);
+
+    for (auto const& backend : backends.subspan(1))
+    {
+        if (auto const diff = compare(expected, backend->run(input)); !diff.empty())
+        {
+            return std::format("{} disagrees with {} from {} over {} steps\n  {}",
+                               backend->name(),
+                               backends.front()->name(),
+                               describe(input.state),
+                               input.steps,
+                               diff);
+        }
+    }
+    return {};
+}
+
+std::vector<std::filesystem::path> backendsFromEnvironment()
+{
+    std::vector<std::filesystem::path> libraries;
+
+    auto const* value = std::getenv("FAUXBOY_FUZZ_BACKENDS");
+    for (auto const part : std::views::split(std::string_view((value != nullptr) ? value : ""), ':'))
+    {
+        if (!part.empty())
+        {
+            libraries.emplace_back(std::string_view(part));
+        }
+    }
+    return libraries;
+}
+} // namespace
+
+#ifdef FAUXBOY_LIBFUZZER
+
+namespace
+{
+std::vector<std::unique_ptr<Backend>>& fuzzBackends()
+{
+    static auto backends = makeBackends(backendsFromEnvironment());
+    return backends;
+}
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(std::uint8_t const* data, std::size_t size)
+{
+    if (auto const diff = check(fuzzBackends(), std::span(data, size)); !diff.empty())
+    {
+        std::cerr << diff << '\n';
+        std::abort();
+    }
+    return 0;
+}
+
+#else
+
+namespace
+{
+Options parseOptions(int argc, char* argv[])
+{
+    Options options;
+    options.backends = backendsFromEnvironment();
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view const arg = argv[i];
+
+        auto const nextValue = [&]
+        {
+            if ((i + 1) >= argc)
+            {
+                throw std::invalid_argument(std::format("Missing value for {}", arg));
+            }
+            return std::string_view(argv[++i]);
+        };
+
+        if (arg == "--backend")
+        {
+            options.backends.emplace_back(nextValue());
+        }
+        else if (arg == "--iterations")
+        {
+            options.iterations = std::stoull(std::string(nextValue()));
+        }
+        else if (arg == "--seed")
+        {
+            options.seed = std::stoull(std::string(nextValue()), nullptr, 0);
+        }
+        else if (arg == "--size")
+        {
+            options.size = std::max<std::size_t>(std::stoull(std::string(nextValue())), HEADER_SIZE);
+        }
+        else if (arg.starts_with("--"))
+        {
+            throw std::invalid_argument(
+                "usage: fauxboy_fuzz [--backend <lib>]... [--iterations N] [--seed N] [--size N] [<input>...]");
+        }
+        else
+        {
+            options.inputs.emplace_back(arg);
+        }
+    }
+    return options;
+}
+
+std::vector<std::uint8_t> readInput(std::filesystem::path const& path)
+{
+    auto ifs = std::ifstream(path, std::ios::binary);
+    if (!ifs.is_open())
+    {
+        throw std::runtime_error(std::format("Could not open file: {}", path.c_str()));
+    }
+    return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(ifs), {});
+}
+
+void saveMismatch(std::span<std::uint8_t const> data)
+{
+    auto const path = std::format("mismatch-{:016x}.bin", hashBytes(data));
+    auto ofs        = std::ofstream(path, std::ios::binary);
+    ofs.write(reinterpret_cast<char const*>(data.data()), static_cast<std::streamsize>(data.size()));
+    std::cout << std::format("  input written to {}\n", path);
+}
+
+int fuzz(Options const& options)
+{
+    auto const backends = makeBackends(options.backends);
+    if (backends.size() < 2)
+    {
+        std::cerr << "warning: no backends to compare against, only checking that the reference does not crash\n";
+    }
+
+    if (!options.inputs.empty())
+    {
+        int result = EXIT_SUCCESS;
+        for (auto const& path : options.inputs)
+        {
+            auto const diff = check(backends, readInput(path));
+            std::cout << std::format("{}: {}\n", path.c_str(), (diff.empty() ? "ok" : diff));
+            result = (diff.empty() ? result : EXIT_FAILURE);
+        }
+        return result;
+    }
+
+    std::cout << std::format("seed 0x{:x}, {} backends\n", options.seed, backends.size());
+
+    auto generator = std::mt19937_64(options.seed);
+    std::vector<std::uint8_t> data(options.size);
+    for (std::uint64_t i = 0; i < options.iterations; ++i)
+    {
+        std::ranges::generate(data, [&generator] { return static_cast<std::uint8_t>(generator()); });
+
+        if (auto const diff = check(backends, data); !diff.empty())
+        {
+            std::cout << std::format("iteration {}: {}\n", i, diff);
+            saveMismatch(data);
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::cout << std::format("{} inputs, no mismatches\n", options.iterations);
+    return EXIT_SUCCESS;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        return fuzz(parseOptions(argc, argv));
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << '\n';
+        return 2;
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,223 @@
+// Runs a directory of accuracy test roms headlessly and in parallel
+//
+// usage: fauxboy_test_roms <rom_dir> [--timeout-cycles N] [--jobs N]
+//
+// Blargg roms report over the serial port and finish with "Passed" or "Failed", Mooneye roms finish on LD B, B with the
+// Fibonacci numbers 3, 5, 8, 13, 21, 34 in B, C, D, E, H, L on success and 0x42 in every register on failure
+
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fauxboy/address.hpp>
+#include <fauxboy/cartridge.hpp>
+#include <fauxboy/cpu.hpp>
+#include <fauxboy/game_boy.hpp>
+
+#include "rom_corpus.hpp"
+
+using namespace fxb;
+
+namespace
+{
+// LD B, B
+constexpr std::uint8_t MOONEYE_BREAKPOINT = 0x40;
+
+struct Options
+{
+    std::filesystem::path romDir;
+    std::uint64_t timeoutCycles = (GameBoy::M_CYCLES_PER_FRAME * 60 * 120);
+    unsigned jobs               = Tools::defaultJobs();
+};
+
+enum class Verdict
+{
+    PASS,
+    FAIL,
+    TIMEOUT,
+    ERROR
+};
+
+struct Outcome
+{
+    Verdict verdict      = Verdict::ERROR;
+    std::uint64_t cycles = 0;
+    std::string detail;
+};
+
+std::string_view toString(Verdict verdict)
+{
+    switch (verdict)
+    {
+        case Verdict::PASS: return "PASS";
+        case Verdict::FAIL: return "FAIL";
+        case Verdict::TIMEOUT: return "TIMEOUT";
+        case Verdict::ERROR: return "ERROR";
+    }
+    return "";
+}
+
+std::string lastLine(std::string_view text)
+{
+    auto const end = text.find_last_not_of("\n ");
+    if (end == std::string_view::npos)
+    {
+        return {};
+    }
+
+    auto const newline = text.find_last_of('\n', end);
+    auto const start   = ((newline == std::string_view::npos) ? 0 : (newline + 1));
+    return std::string(text.substr(start, (end + 1 - start)));
+}
+
+Outcome checkMooneye(Cpu const& cpu)
+{
+    if ((cpu.B() == 3) && (cpu.C() == 5) && (cpu.D() == 8) && (cpu.E() == 13) && (cpu.H() == 21) && (cpu.L() == 34))
+    {
+        return {.verdict = Verdict::PASS, .detail = {}};
+    }
+    return {.verdict = Verdict::FAIL,
+            .detail  = std::format("B={:02X} C={:02X} D={:02X} E={:02X} H={:02X} L={:02X}",
+                                  cpu.B(),
+                                  cpu.C(),
+                                  cpu.D(),
+                                  cpu.E(),
+                                  cpu.H(),
+                                  cpu.L())};
+}
+
+Outcome run(std::filesystem::path const& path, std::uint64_t timeoutCycles)
+{
+    std::string serial;
+
+    try
+    {
+        GameBoy gameBoy(Cartridge::load(path));
+        gameBoy.mmu().setOnSerialCallback([&serial](std::uint8_t value) { serial += static_cast<char>(value); });
+
+        auto const finish = [&gameBoy](Outcome outcome)
+        {
+            outcome.cycles = gameBoy.cycles();
+            return outcome;
+        };
+
+        std::size_t checkedSize = 0;
+        while (gameBoy.cycles() < timeoutCycles)
+        {
+            auto const& cpu = gameBoy.cpu();
+            if (gameBoy.mmu().read(Address(cpu.PC())) == MOONEYE_BREAKPOINT)
+            {
+                return finish(checkMooneye(cpu));
+            }
+
+            gameBoy.step();
+
+            if (serial.size() == checkedSize)
+            {
+                continue;
+            }
+            checkedSize = serial.size();
+
+            if (serial.contains("Passed"))
+            {
+                return finish({.verdict = Verdict::PASS, .detail = {}});
+            }
+            // Blargg prints the failing test number after the verdict, wait for the whole line
+            if (serial.contains("Failed") && serial.ends_with('\n'))
+            {
+                return finish({.verdict = Verdict::FAIL, .detail = lastLine(serial)});
+            }
+        }
+
+        return finish({.verdict = Verdict::TIMEOUT, .detail = lastLine(serial)});
+    }
+    catch (std::exception const& e)
+    {
+        return {.verdict = Verdict::ERROR, .detail = e.what()};
+    }
+}
+
+Options parseOptions(int argc, char* argv[])
+{
+    Options options;
+    std::vector<std::string_view> positional;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view const arg = argv[i];
+
+        auto const nextValue = [&]
+        {
+            if ((i + 1) >= argc)
+            {
+                throw std::invalid_argument(std::format("Missing value for {}", arg));
+            }
+            return std::stoull(argv[++i]);
+        };
+
+        if (arg == "--timeout-cycles")
+        {
+            options.timeoutCycles = nextValue();
+        }
+        else if (arg == "--jobs")
+        {
+            options.jobs = std::max(1u, static_cast<unsigned>(nextValue()));
+        }
+        else
+        {
+            positional.push_back(arg);
+        }
+    }
+
+    if (positional.size() != 1)
+    {
+        throw std::invalid_argument("usage: fauxboy_test_roms <rom_dir> [--timeout-cycles N] [--jobs N]");
+    }
+    options.romDir = positional[0];
+    return options;
+}
+
+int runAll(Options const& options)
+{
+    auto const roms = Tools::findRoms(options.romDir);
+
+    std::vector<Outcome> outcomes(roms.size());
+    Tools::parallelFor(roms.size(),
+                       options.jobs,
+                       [&](std::size_t index) { outcomes[index] = run(roms[index], options.timeoutCycles); });
+
+    std::size_t passed = 0;
+    for (std::size_t i = 0; i < roms.size(); ++i)
+    {
+        auto const& outcome = outcomes[i];
+        passed += (outcome.verdict == Verdict::PASS);
+
+        auto const name = std::filesystem::relative(roms[i], options.romDir).string();
+        std::cout << std::format(
+            "{:<8}{:<56}{:>14}  {}\n", toString(outcome.verdict), name, outcome.cycles, outcome.detail);
+    }
+    std::cout << std::format("\n{}/{} passed\n", passed, roms.size());
+
+    return ((passed == roms.size()) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        return runAll(parseOptions(argc, argv));
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << '\n';
+        return 2;
+    }
+}
\ No newline at end of file